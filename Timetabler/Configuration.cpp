@@ -23,6 +23,7 @@ int Configuration::parseFile(const char* fileName) {
     _students.clear();
     _prevSolution.clear();
     _prevSolutionLoaded = false;
+    setWeights( TTWeights() );
     
     //open file
     ifstream input(fileName);
@@ -69,6 +70,8 @@ int Configuration::parseFile(const char* fileName) {
             _prevSolution = prevSolution;
             _prevSolutionLoaded = true;
         }
+        else if (line.compare("#weights") == 0 )
+            setWeights( ParseWeights( input ) );
     }
     
     input.close();
@@ -76,6 +79,7 @@ int Configuration::parseFile(const char* fileName) {
     _isEmpty = false;
     
     processNotSlots(); // Work out the _notSlots element for each tutor
+    processConstraints();
     
     cout << "Input from file: "<<numStudents()<<" students, "<<numTutors()<<" tutors and "<<numSubjects()<<" subjects.\n";
 
@@ -88,6 +92,7 @@ void Configuration::setup( hash_map<int, Tutor*> tutors, hash_map<int, Subject*>
     _tutors = tutors; _subjects=subjects; _students=students;
     
     processNotSlots(); // Work out the _notSlots element for each tutor and student
+    processConstraints();
     
     _isEmpty = false;
     
@@ -191,6 +196,55 @@ vector<list<int> > Configuration::ParseSolution(ifstream& file) {
     
 }
 
+// Reads the #weights block, leaving out anything that would make no sense to score by
+TTWeights Configuration::ParseWeights(ifstream& file) {
+    
+    TTWeights weights;
+    
+    while (!file.eof()) {
+        
+        string key, value;
+        
+        if ( !GetConfigBlockLine(file, key, value)) break;
+        
+        if ( key.compare("comment") == 0 ) continue;
+        
+        int criterion = 0;
+        while ( criterion < TT_NUM_CRITERIA && key.compare( TTWeights::getKey( (TTCriterion)criterion ) ) != 0 ) criterion++;
+        
+        if (criterion == TT_NUM_CRITERIA) {
+            cerr << "Unknown weight \"" << key << "\" ignored\n";
+            continue;
+        }
+        
+        // A negative weight would reward breaking the criterion
+        double points = atof(value.c_str());
+        if (points < 0) {
+            cerr << "Weight " << key << " = " << value << " is negative: using the default\n";
+            continue;
+        }
+        
+        weights.setPoints( (TTCriterion)criterion, points );
+        
+        // Scores are counted in whole SCORE_UNITS, so anything smaller comes out as no weight at all
+        if (points > 0 && !weights.isEnabled( (TTCriterion)criterion ))
+            cerr << "Weight " << key << " = " << value << " is less than 1/" << SCORE_UNITS << " of a point: it won't be scored\n";
+    }
+    
+    // With nothing but stability scored, there'd be no telling timetables apart without a previous solution, and
+    //   the best possible score could be 0
+    long long scored = 0;
+    for (int i = 0; i < TT_NUM_CRITERIA; i++)
+        if (i != TT_CRIT_STABILITY) scored += weights.units[i];
+    
+    if (scored == 0) {
+        cerr << "Weights score nothing but stability: using the defaults\n";
+        return TTWeights();
+    }
+    
+    return weights;
+}
+
 // Returns a tutor's subject and proficiency given a string formatted "SUBJ : PROF"
 pair<Subject*, float> Configuration::ParseTutorSubject(const string input) {
     
@@ -279,6 +333,166 @@ void Configuration::processNotSlots() {
     
 }
 
+// Build the dense constraint tables used by the fitness function. Tutor IDs run from 1 to numTutors()
+void Configuration::processConstraints() {
+    
+    int nTutors = numTutors();
+    
+    _constraints.clear();
+    _studentVector.assign( _students.begin(), _students.end() );
+    
+    // Which slots can each tutor do?
+    _tutorCanDoSlot.assign( SLOTS_IN_DAY * nTutors, true );
+    for (hash_map<int, Tutor*>::iterator it = _tutors.begin(); it != _tutors.end(); it++) {
+        list<int> notTimes = (*it).second->getNotTimes();
+        for (list<int>::iterator itTime = notTimes.begin(); itTime != notTimes.end(); itTime++)
+            if ( *itTime >= 0 && *itTime < SLOTS_IN_DAY )
+                _tutorCanDoSlot[ ((*it).first - 1) * SLOTS_IN_DAY + *itTime ] = false;
+    }
+    
+    _anyPrevTutors = false;
+    
+    // Group the students by baseID
+    hash_map<int, vector<Student*> > byBaseID;
+    for (list<Student*>::iterator it = _students.begin(); it != _students.end(); it++)
+        byBaseID[ (*it)->getBaseID() ].push_back(*it);
+    
+    for (list<Student*>::iterator it = _students.begin(); it != _students.end(); it++) {
+        Student* stu = *it;
+        StudentConstraints& c = _constraints[stu];
+        
+        c.siblings = byBaseID[ stu->getBaseID() ];
+        
+        c.proficiency.assign( nTutors, -1 );
+        for (hash_map<int, Tutor*>::iterator itTut = _tutors.begin(); itTut != _tutors.end(); itTut++) {
+            map<Subject*, float> subjects = (*itTut).second->getSubjects();
+            map<Subject*, float>::iterator found = subjects.find( stu->getSubject() );
+            if ( found != subjects.end() )
+                c.proficiency[ (*itTut).first - 1 ] = (*found).second;
+        }
+        
+        c.prevTutor.assign( nTutors, false );
+        list<Tutor*> prevTutors = stu->getPrevTutors();
+        for (list<Tutor*>::iterator itPrev = prevTutors.begin(); itPrev != prevTutors.end(); itPrev++)
+            if ( *itPrev && (*itPrev)->getID() >= 1 && (*itPrev)->getID() <= nTutors ) {
+                c.prevTutor[ (*itPrev)->getID() - 1 ] = true;
+                _anyPrevTutors = true;
+            }
+        
+        c.canDoTime.assign( SLOTS_IN_DAY, true );
+        list<int> notTimes = stu->getNotTimes();
+        for (list<int>::iterator itTime = notTimes.begin(); itTime != notTimes.end(); itTime++)
+            if ( *itTime >= 0 && *itTime < SLOTS_IN_DAY )
+                c.canDoTime[ *itTime ] = false;
+        
+        c.canDoSlot.assign( SLOTS_IN_DAY * nTutors, false );
+        c.feasibleSlots.clear();
+        for (int slot = 0; slot < SLOTS_IN_DAY * nTutors; slot++) {
+            if ( c.proficiency[ slot / SLOTS_IN_DAY ] >= 0 && c.canDoTime[ slot % SLOTS_IN_DAY ] && _tutorCanDoSlot[slot] ) {
+                c.canDoSlot[slot] = true;
+                c.feasibleSlots.push_back(slot);
+            }
+        }
+    }
+    
+    processComponents();
+    processTerms();
+    processMaxUnits();
+}
+
+// The minor terms with any weight. Previous tutors are left out too when no student has any, since every
+//   interview would score the same for them
+void Configuration::processTerms() {
+    
+    _terms = _weights.getTerms();
+    
+    if (!_anyPrevTutors) _terms &= ~TT_TERM_PREV_TUTOR;
+}
+
+// Every criterion for each student (6.1 points with the default weights), bar grouping and stability, plus the
+//   grouping bonus for each of their other interviews: see TTFitness::scoreStudent. Stability depends on the
+//   chromosome, so TTFitness::maxUnits adds it. Previous tutors only count if they're scored (see processTerms)
+void Configuration::processMaxUnits() {
+    
+    long long perStudent = 0;
+    for (int i = 0; i < TT_NUM_CRITERIA; i++)
+        if (i != TT_CRIT_GROUPING && i != TT_CRIT_STABILITY) perStudent += _weights.units[i];
+    
+    if ( !(_terms & TT_TERM_PREV_TUTOR) ) perStudent -= _weights.units[TT_CRIT_PREV_TUTOR];
+    
+    _maxStudentUnits = 0;
+    for (list<Student*>::iterator it = _students.begin(); it != _students.end(); it++)
+        _maxStudentUnits += perStudent + ( (*it)->getNoInterviews() - 1 ) * _weights.units[TT_CRIT_GROUPING];
+}
+
+// Root of x's tree in a union-find forest, halving the path on the way
+static int findRoot(vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[ parent[x] ];
+        x = parent[x];
+    }
+    return x;
+}
+
+void Configuration::processComponents() {
+    
+    int nTutors = numTutors();
+    
+    _components.clear();
+    _componentOfTutor.assign( nTutors, -1 );
+    
+    // Join up the tutors who teach each student's subject
+    vector<int> parent( nTutors );
+    for (int t = 0; t < nTutors; t++) parent[t] = t;
+    
+    for (list<Student*>::iterator it = _students.begin(); it != _students.end(); it++) {
+        const vector<float>& proficiency = _constraints[*it].proficiency;
+        int first = -1;
+        
+        for (int t = 0; t < nTutors; t++) {
+            if ( proficiency[t] < 0 ) continue;
+            
+            if (first < 0) first = t;
+            else parent[ findRoot(parent, t) ] = findRoot(parent, first);
+        }
+    }
+    
+    // Then number the trees that have students in them, in the order the students come
+    vector<int> componentOfRoot( nTutors, -1 );
+    
+    for (list<Student*>::iterator it = _students.begin(); it != _students.end(); it++) {
+        StudentConstraints& c = _constraints[*it];
+        c.component = -1;
+        
+        for (int t = 0; t < nTutors && c.component < 0; t++) {
+            if ( c.proficiency[t] < 0 ) continue;
+            
+            int root = findRoot(parent, t);
+            if ( componentOfRoot[root] < 0 ) {
+                componentOfRoot[root] = (int)_components.size();
+                _components.push_back( SubjectComponent() );
+            }
+            c.component = componentOfRoot[root];
+        }
+        
+        if (c.component >= 0) _components[c.component].students.push_back(*it);
+    }
+    
+    for (int t = 0; t < nTutors; t++) {
+        _componentOfTutor[t] = componentOfRoot[ findRoot(parent, t) ];
+        if ( _componentOfTutor[t] >= 0 ) _components[ _componentOfTutor[t] ].tutors.push_back(t);
+    }
+}
+
+int Configuration::largestComponent() const {
+    
+    int largest = 0;
+    for (vector<SubjectComponent>::const_iterator it = _components.begin(); it != _components.end(); it++)
+        largest = max( largest, (int)(*it).students.size() );
+    
+    return largest;
+}
+
 void Configuration::dumpTutors(){
     //Print info about all the tutors
     hash_map<int, Tutor*> theTutors = _tutors;
@@ -356,6 +570,8 @@ bool Configuration::removeSubject( Subject* s ) {
         //now, remove all students if this subject was theirs. Maybe think of a better way to handle this. edit.
         _students.remove_if( [s](Student* thisS){ return thisS->getSubject() == s; } );
         
+        processConstraints();
+        
         return true;
     }
     
@@ -375,6 +591,12 @@ void Configuration::saveConfig(string filename) {
     "%	these MUST start at 1 and ascend from there, else the\n"
     "%	slot identification will break\n\n";
     
+    // the scoring weights, in points. A weight of 0 turns the criterion off
+    output << "#weights\n";
+    for (int i = 0; i < TT_NUM_CRITERIA; i++)
+        output << "\t" << TTWeights::getKey( (TTCriterion)i ) << " = " << _weights.getPoints( (TTCriterion)i ) << endl;
+    output << "#end\n\n";
+    
     // output the subjects
     for (hash_map<int, Subject*>::iterator it = _subjects.begin(); it != _subjects.end(); it++) {
         
@@ -17,10 +17,30 @@
 using namespace __gnu_cxx;
 
 #include "TTChromosone.h"
+#include "TTWeights.h"
 #include "Student.h"
 #include "Tutor.h"
 #include "Subject.h"
 
+// Dense view of the constraints on one student-interview, built once the configuration is loaded
+// so that the fitness function doesn't have to copy lists out of the Student and Tutor objects
+struct StudentConstraints {
+    vector<Student*> siblings;  // every interview with this student's baseID, including this one
+    vector<float> proficiency;  // indexed by tutorID-1. Negative if the tutor doesn't teach the subject
+    vector<bool> prevTutor;     // indexed by tutorID-1
+    vector<bool> canDoTime;     // indexed by time
+    vector<bool> canDoSlot;     // indexed by slot: the tutor teaches the subject and the tutor and student can both do the time
+    vector<int> feasibleSlots;  // the slots in canDoSlot, in order
+    int component;              // index into Configuration::getComponents(), or -1 if nobody teaches the subject
+};
+
+// Students and tutors that nobody else has anything to do with: the students' subjects are only taught by these
+// tutors, and these tutors only teach these students' subjects. Usually one per subject, unless tutors teach several
+struct SubjectComponent {
+    vector<int> tutors;         // tutorID-1, ascending
+    vector<Student*> students;
+};
+
 class Configuration {
 private:
     static Configuration _instance; // Global instance
@@ -49,9 +69,28 @@ private:
     // e.g. if we've added 3 students then 3 previously empty slots will need to be filled
     // we therefore reduce the maxscore accordingle to compensate for this.
     int _changedSlots=0;
+    
+    // What each criterion is worth, and which of the minor terms that leaves to be scored (see processTerms)
+    TTWeights _weights;
+    int _terms;
+    
+    // Does any student have a previous tutor to avoid? If not, every interview meets that criterion
+    bool _anyPrevTutors;
+    
+    // Most a timetable of all the students can score, bar stability (see processMaxUnits)
+    long long _maxStudentUnits;
+    
+    // Constraint tables (see processConstraints)
+    hash_map<Student*, StudentConstraints> _constraints;
+    vector<Student*> _studentVector; // The students again, for constant time random access
+    vector<bool> _tutorCanDoSlot;    // indexed by slot
+    
+    // Decomposition of the students and tutors (see processComponents)
+    vector<SubjectComponent> _components;
+    vector<int> _componentOfTutor;   // indexed by tutorID-1, -1 for tutors whose subjects nobody's taking
 public:
     // Init
-    Configuration() : _isEmpty(true) {}
+    Configuration() : _isEmpty(true), _terms( _weights.getTerms() ), _anyPrevTutors(false), _maxStudentUnits(0) {}
     
     //wipe the config
     inline void clear() { _isEmpty=true; _tutors.clear(); _subjects.clear(); _students.clear(); }
@@ -64,7 +103,7 @@ public:
     void dumpSolution();
 
     
-    inline vector<list<int> > getPrevSolution() { return _prevSolution; }
+    inline const vector<list<int> >& getPrevSolution() { return _prevSolution; }
     inline bool prevSolutionLoaded() { return _prevSolutionLoaded; }
 
     // get number of changed slots
@@ -73,6 +112,13 @@ public:
     inline int incrementChangedSlots() { return _changedSlots++; }
     inline void resetChangedSlots() { _changedSlots = 0; }
     
+    inline const TTWeights& getWeights() const { return _weights; }
+    inline int getTerms() const { return _terms; }
+    inline void setWeights(const TTWeights& weights) { _weights = weights; processTerms(); processMaxUnits(); }
+    
+    // Most the students can score with the current weights, bar stability, in SCORE_UNITS. Used by TTFitness::maxUnits
+    inline long long getMaxStudentUnits() const { return _maxStudentUnits; }
+    
     // removes tutor t from the previous solution and adjusts all the slot values to compensate
     void removeTutorFromPrev(Tutor* t);
     
@@ -111,6 +157,16 @@ public:
     
     list<Student*> getStudentsByBaseID(int baseID);
     
+    // Constraint tables, valid once the config has been parsed or set up
+    inline const StudentConstraints& getConstraints(Student* s) const { return (*_constraints.find(s)).second; }
+    inline const vector<Student*>& getStudentVector() const { return _studentVector; }
+    inline bool tutorCanDoSlot(int slot) const { return _tutorCanDoSlot[slot]; }
+    inline const vector<SubjectComponent>& getComponents() const { return _components; }
+    inline int componentOfTutor(int tutor) const { return _componentOfTutor[tutor]; }
+    
+    // Number of student-interviews in the largest component
+    int largestComponent() const;
+    
     //Return whole hash_map of tutors/subjects
     inline hash_map<int, Tutor*> getTutors() { return _tutors; }
     inline hash_map<int, Subject*> getSubjects() { return _subjects; }
@@ -129,7 +185,7 @@ public:
     
     //set up Configuration using arguments
     void setup( hash_map<int, Tutor*> tutors, hash_map<int, Subject*> subjects, list<Student*> students );
-
+    
     // Given an object, add it to the relevant list
     inline void addSubject( Subject* s ) { _subjects.insert( pair<int, Subject*>( s->getID(), s ) ); }
     inline void addTutor( Tutor* t ) { _tutors.insert( pair<int, Tutor*>( t->getID(), t ) ); }
@@ -168,11 +224,27 @@ private:
     // Returns NULL if method cannot parse configuration data
     vector<list<int> > ParseSolution(ifstream& file);
     
+    // Reads the scoring weights, in points, into a copy of the defaults and returns it
+    TTWeights ParseWeights(ifstream& file);
+    
 	// Reads one line (key - value pair) from configuration file
 	bool GetConfigBlockLine(ifstream& file, string& key, string& value);
     
     //Processes the slots that tutors and students can't do for each
     void processNotSlots();
+    
+    // Builds the constraint tables used by the fitness function
+    void processConstraints();
+    
+    // Works out _terms, which depends on the weights and whether any student has previous tutors
+    void processTerms();
+    
+    // Works out _maxStudentUnits, which depends on the students, the weights and _terms
+    void processMaxUnits();
+    
+    // Splits the students and tutors into connected components of the graph linking each student to
+    //   the tutors who teach their subject. Components can be timetabled independently of each other
+    void processComponents();
 };
 
 #endif /* defined(__Timetabler__Configuration__) */
@@ -78,6 +78,16 @@ namespace Chromosome
 		return ( *_population->GetConfiguration().GetSortComparator() )( GetFitnessForComparison(), c );
 	}
 
+	// Compares fitnesses of two chromosomes, as above. Unless scaled fitness values are used the comparator
+	// sees the chromosomes themselves, so it can tell apart chromosomes with equal fitness values
+	int GaScaledChromosome::CompareFitnesses(const GaScaledChromosome& c) const
+	{
+		if( _population->IsScaledFitnessUsed() )
+			return CompareFitnesses( c.GetFitnessForComparison() );
+
+		return ( *_population->GetConfiguration().GetSortComparator() )( *_chromosome, *c._chromosome );
+	}
+
 	// Sets index of chromosome in pupulation
 	void GaScaledChromosome::SetIndex(int index)
 	{
@@ -344,6 +344,7 @@ namespace Chromosome
 
 		/// <summary>This method compares fitness values of two chromosomes (<c>this</c> and <c>c</c>).
 		/// Which fitness value (scaled or original) is going to be used depends on flag set in population to which chromosomes are bound.
+		/// If original values are used, the population's comparator is given the chromosomes themselves.
 		/// NOTE: Comparison doesn't have to be arithmetical comparison.
 		///
 		/// This method is not thread-safe.</summary>
@@ -351,7 +352,8 @@ namespace Chromosome
 		/// <returns>a) -1 if fitness value of <c>this</c> is lower then value of <c>c</c>.
 		/// <br>b) 0 if fitness values of both chromosomes are equal.
 		/// <br>c) 1 if fitness value of <c>this</c> is greater then value of <c>c</c>. </returns>
-		inline int GACALL CompareFitnesses(const GaScaledChromosome& c) const { return CompareFitnesses( c.GetFitnessForComparison() ); }
+		GAL_API
+		int GACALL CompareFitnesses(const GaScaledChromosome& c) const;
 
 		/// <summary>This method compares fitness values of two chromosomes (<c>this</c> and <c>c</c>).
 		/// Which fitness value (scaled or original) is going to be used depends on flag set in population to which chromosomes are bound.
@@ -125,6 +125,17 @@ namespace Chromosome
 		virtual int GACALL operator ()(float fitness1,
 			float fitness2) const=0;
 
+		/// <summary>This operator compares two chromosomes by their fitness. By default it compares their fitness values,
+		/// but comparators which can tell apart chromosomes with equal fitness values can override it.
+		/// Populations use it to sort chromosomes unless they use scaled fitness values.</summary>
+		/// <param name="chromosome1">the first chromosome.</param>
+		/// <param name="chromosome2">the second chromosome.</param>
+		/// <returns>a. -1 if the first chromosome is worse then the second.
+		/// <br>b.  0 if the chromosomes are equally good.
+		/// <br>c.  1 if the first chromosome is better then the second.</returns>
+		virtual int GACALL operator ()(const GaChromosome& chromosome1,
+			const GaChromosome& chromosome2) const { return (*this)( chromosome1.GetFitness(), chromosome2.GetFitness() ); }
+
 		/// <summary>This method just overrides <see cref="GaOperation::MakeParameters" /> method and has no functionality.</summary>
 		/// <returns>Method always returns <c>NULL</c>.</returns>
 		virtual GaParameters* GACALL MakeParameters() const { return NULL; }
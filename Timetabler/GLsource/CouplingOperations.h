@@ -43,6 +43,14 @@ namespace Population
 	namespace CouplingOperations
 	{
 
+		/// <summary><c>CheckForDuplicates</c> checks whether the chromosome already exists in the population.</summary>
+		/// <param name="population">population against which the new chromosome should be tested.</param>
+		/// <param name="newChromosome">chromosome that should be checked.</param>
+		/// <returns>Method returns <c>true</c> if at least one equal chromosome is found in the population.</returns>
+		GAL_API
+		bool GACALL CheckForDuplicates(const GaPopulation& population,
+			const GaChromosome& newChromosome);
+
 		/// <summary><c>GaSimpleCoupling</c> coupling takes first two parents and it produces two child using crossover operations,
 		/// and each parent is bound to one child, then it takes next two parents, and so on... If all parents are used, but more children should be produced,
 		/// this coupling operation wraps-around parent counter and starts from beginning until enough children is produced.
@@ -127,6 +127,7 @@ void GaInitialize()
 	GaStopCriteriaCatalogue::Instance().Register( "GaFitnessCriteria", new GaFitnessCriteria() );
 	GaStopCriteriaCatalogue::Instance().Register( "GaFitnessProgressCriteria", new GaFitnessProgressCriteria() );
 	GaStopCriteriaCatalogue::Instance().Register( "GaGenerationCriteria", new GaGenerationCriteria() );
+	GaStopCriteriaCatalogue::Instance().Register( "GaTimeCriteria", new GaTimeCriteria() );
 
 	// default setup for population operations
 	GaPopulationConfiguration::MakeDefault();
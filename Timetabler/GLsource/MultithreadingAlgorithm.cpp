@@ -243,8 +243,12 @@ namespace Algorithm
 			if( _parametersChange )
 				break;
 
+			// the control thread holds the state until every worker's done this step, so all the workers see the same state here.
+			// the state seen later may already have been changed by the control thread for the next step
+			bool running = _state == GAS_RUNNING;
+
 			// execute work step if the algorithm is not stopped
-			if( _state == GAS_RUNNING )
+			if( running )
 				WorkStep( workerId );
 
 			// only the last worker will releast the others to continue
@@ -259,7 +263,7 @@ namespace Algorithm
 				SignalEvent( _controlSync );
 
 			// algorithm is stopped
-			if( _state != GAS_RUNNING )
+			if( !running )
 				break;
 		}
 	}
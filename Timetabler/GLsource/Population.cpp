@@ -79,11 +79,9 @@ namespace Population
 
 		int rev = _type == GASGT_WORST ? -1 : 1;
 
-		float fitness = _population->GetAt( chromosomeIndex ).GetFitnessForComparison();
-
 		// the group is full, qickly check if the chromosome should be in the group
 		if( _currentSize == _maxSize && 
-			rev * (*_comparator)( fitness, _population->GetAt( _chromosomesIndecies[ _currentSize - 1 ] ).GetFitnessForComparison() ) <= 0 )
+			rev * Compare( chromosomeIndex, _chromosomesIndecies[ _currentSize - 1 ] ) <= 0 )
 			return -1;
 
 		// if the last chromosome from this group will be removed,
@@ -94,7 +92,7 @@ namespace Population
 
 		// find position at which the chromosome should be inserted and make room for it
 		int i = _currentSize < _maxSize ? _currentSize : _maxSize - 1;
-		for( ; i > 0 && rev * (*_comparator)( fitness, _population->GetAt( _chromosomesIndecies[ i - 1 ] ).GetFitnessForComparison() ) > 0; i-- )
+		for( ; i > 0 && rev * Compare( chromosomeIndex, _chromosomesIndecies[ i - 1 ] ) > 0; i-- )
 			_chromosomesIndecies[ i ] = _chromosomesIndecies[ i - 1 ];
 
 		// insert new chromosome
@@ -121,10 +119,8 @@ namespace Population
 
 		int rev = _type == GASGT_WORST ? -1 : 1;
 
-		float fitness = _population->GetAt( chromosomeIndex ).GetFitnessForComparison();
-
 		// qickly check if the chromosome should be in the group
-		if( rev * (*_comparator)( fitness, _population->GetAt( _chromosomesIndecies[ _currentSize - 1 ] ).GetFitnessForComparison() ) < 0 )
+		if( rev * Compare( chromosomeIndex, _chromosomesIndecies[ _currentSize - 1 ] ) < 0 )
 			return false;
 
 		// find position of chromosome's index in the group
@@ -178,8 +174,7 @@ namespace Population
 		int rev = _type == GASGT_WORST ? -1 : 1;
 
 		// qickly check if the chromosome should be in the group
-		float fitness = _population->GetAt( chromosomeIndex ).GetFitnessForComparison();
-		if( rev * (*_comparator)( fitness, _population->GetAt( _chromosomesIndecies[ _currentSize - 1 ] ).GetFitnessForComparison() ) < 0 )
+		if( rev * Compare( chromosomeIndex, _chromosomesIndecies[ _currentSize - 1 ] ) < 0 )
 			return -1;
 
 		// find chromosome
@@ -193,6 +188,20 @@ namespace Population
 		return -1;
 	}
 
+	// Compares two chromosomes of the population. Unless scaled fitness values are used the comparator
+	// sees the chromosomes themselves
+	int GaSortedGroup::Compare(int first,
+		int second) const
+	{
+		const GaScaledChromosome& c1 = _population->GetAt( first );
+		const GaScaledChromosome& c2 = _population->GetAt( second );
+
+		if( _population->IsScaledFitnessUsed() )
+			return ( *_comparator )( c1.GetFitnessForComparison(), c2.GetFitnessForComparison() );
+
+		return ( *_comparator )( *c1.GetChromosome(), *c2.GetChromosome() );
+	}
+
 	// Returns refernece to scaled chromosome at given position
 	GaScaledChromosome& GaSortedGroup::GetScaledChromosomeAt(int pos) const
 	{
@@ -256,7 +265,7 @@ namespace Population
 			{
 				int c = _chromosomesIndecies[ i ];
 				int j = i - 1;
-				for( ; j >= 0 && rev * ( *_comparator )( _population->GetAt( _chromosomesIndecies[ j ] ), _population->GetAt( c ) ) > 0; j-- )
+				for( ; j >= 0 && rev * Compare( _chromosomesIndecies[ j ], c ) > 0; j-- )
 					_chromosomesIndecies[ j + 1 ] = _chromosomesIndecies[ j ];
 
 				_chromosomesIndecies[ j + 1 ] = c;
@@ -547,6 +556,37 @@ namespace Population
 		}
 	}
 
+	// Removes all chromosomes from population and fills it with chromosomes which have already been made and evaluated
+	void GaPopulation::InitializePopulation(GaChromosomePtr* chromosomes)
+	{
+		// verify population parameters
+		if( !_chromosomes || !chromosomes )
+			return;
+
+		// clear best and worst chromosome tracking
+		_best.Clear();
+		_worst.Clear();
+
+		// fill the population
+		for( int i = 0; i < _parameters.GetPopulationSize(); i++ )
+		{
+			// remove old chromosome if any
+			if( _chromosomes[ i ] )
+				delete _chromosomes[ i ];
+
+			// add new chromosome to the population
+			_chromosomes[ i ] = new GaScaledChromosome( chromosomes[ i ], this, i );
+		}
+
+		// initialize statistics
+		_statistics.Clear();
+
+		_currentSize = _parameters.GetPopulationSize();
+
+		// sort population if needed
+		ResortPopulation( true, true, true );
+	}
+
 	// Fills the given array with indices of the best chromosomes in the population
 	// Returns number of saved chromosomes
 	int GaPopulation::GetBestChromosomes(int* results,
@@ -1612,6 +1652,8 @@ namespace Population
 		int best = 0;
 		if( GetBestChromosomes( &best, 0, 1 ) )
 		{
+			// the best chromosome by the comparator, whose fitness value isn't necessarily the highest
+			_statistics.SetBestChromosome( _chromosomes[ best ]->GetChromosome() );
 			_statistics.ChangeValue( GSV_BEST_FITNESS, _chromosomes[ best ]->GetChromosome()->GetFitness(), false );
 			_statistics.ChangeValue( GSV_BEST_FITNESS_SCALED, _chromosomes[ best ]->GetScaledFitness(), false );
 		}
@@ -490,6 +490,15 @@ namespace Population
 		GAL_API
 		void GACALL InitializePopulation(bool fill = true);
 
+		/// <summary>This method removes all chromosomes from population and fills it with provided chromosomes, which must already
+		/// have their fitness values calculated. This allows the chromosomes to be built and evaluated elsewhere, for instance by several threads.
+		/// It sorts new chromosomes if needed and update sorted groups and statistical information.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <param name="chromosomes">array of chromosomes. Its size must be equal to the population size specified by population's parameters.</param>
+		GAL_API
+		void GACALL InitializePopulation(GaChromosomePtr* chromosomes);
+
 		/// <summary>This method fills provided array with indices of best chromosomes in population. If population is not sorted this method can only
 		/// provide number of best chromosomes which is equal to number of tracked best chromosomes.
 		///
@@ -703,7 +712,7 @@ namespace Population
 		/// <summary>This method is not thread-safe.</summary>
 		/// <returns>Method returns <c>true</c> if population use scale fitness values for sorting.
 		/// If population use non-scaled fitness values, it returns <c>false</c>. </returns>
-		inline bool GACALL IsScaledFitnessUsed() { return _usingScaledFitness; }
+		inline bool GACALL IsScaledFitnessUsed() const { return _usingScaledFitness; }
 
 		/// <summary>This method is not thread-safe.</summary>
 		/// <returns>Method returns pointer to chromosome which is used as prototype during initialization of population.</returns>
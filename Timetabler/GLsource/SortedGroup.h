@@ -74,6 +74,14 @@ namespace Population
 		/// <summary>Type of sorted group.</summary>
 		GaSortedGroupType _type;
 
+		/// <summary>Compares two chromosomes of the population using the group's comparator, in the way
+		/// <see cref="GaScaledChromosome::CompareFitnesses" /> does.</summary>
+		/// <param name="first">index of the first chromosome.</param>
+		/// <param name="second">index of the second chromosome.</param>
+		/// <returns>Method returns -1, 0 or 1 as the comparator does.</returns>
+		int GACALL Compare(int first,
+			int second) const;
+
 	public:
 
 		/// <summary>This constructor allocates memory for array of chromosomes' indices, and initializes comparator, group type,
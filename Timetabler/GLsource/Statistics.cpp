@@ -48,6 +48,8 @@ namespace Common
 			_values[ i ].SetCurrent( 0 );
 			_values[ i ].SetPrevious( 0 );
 		}
+
+		_bestChromosome = NULL;
 	}
 
 	// The generation switch, updates statistical information for new and previous generation.
@@ -78,6 +80,8 @@ namespace Common
 		{
 			for( int i = 0; i < GaNumberOfStatValueTypes; i++ )
 				_values[ i ].SetCurrent( stats._values[ i ].GetCurrent() );
+
+			_bestChromosome = stats._bestChromosome;
 		}
 
 		// copy current generation
@@ -134,7 +138,14 @@ namespace Common
 		float a = _values[ GSV_BEST_FITNESS ].GetCurrent();
 		float b = rhs._values[ GSV_BEST_FITNESS ].GetCurrent();
 
-		_values[ GSV_BEST_FITNESS ].SetCurrent( ( *_fitnessComparator )( a, b ) > 0 ? a : b );
+		// the comparator may tell the best chromosomes apart by more than their fitness values
+		bool rhsBetter = !_bestChromosome.IsNULL() && !rhs._bestChromosome.IsNULL()
+			? ( *_fitnessComparator )( *_bestChromosome, *rhs._bestChromosome ) < 0
+			: ( *_fitnessComparator )( a, b ) <= 0;
+
+		_values[ GSV_BEST_FITNESS ].SetCurrent( rhsBetter ? b : a );
+		if( rhsBetter )
+			_bestChromosome = rhs._bestChromosome;
 		_values[ GSV_BEST_FITNESS_SCALED ].SetCurrent( 0 );
 
 		// fitness of the worst chromosome
@@ -177,6 +177,9 @@ namespace Common
 		/// <summary>Fitness comparator used to compare statistical values.</summary>
 		const GaFitnessComparator* _fitnessComparator;
 
+		/// <summary>The best chromosome in population(s), whose fitness is <c>GSV_BEST_FITNESS</c>. <c>NULL</c> if it is not known.</summary>
+		GaChromosomePtr _bestChromosome;
+
 	public:
 
 		// Initialize statistical information
@@ -253,6 +256,18 @@ namespace Common
 		/// <returns>Returns pointer to fitness comparator used to compare statistical values.</returns>
 		inline const GaFitnessComparator* GACALL GetFitnessComarator() const { return _fitnessComparator; }
 
+		/// <summary>The best chromosome is the best one by the fitness comparator, which can rank chromosomes by more than
+		/// their fitness values. So <c>GSV_BEST_FITNESS</c> is its fitness value, which is not necessarily the highest one, and
+		/// progress should be measured by comparing the chromosomes themselves.
+		///
+		/// This method is not thread-safe.</summary>
+		/// <returns>Returns smart pointer to the best chromosome, or <c>NULL</c> if it is not known.</returns>
+		inline const GaChromosomePtr& GACALL GetBestChromosome() const { return _bestChromosome; }
+
+		/// <summary>This method is not thread-safe.</summary>
+		/// <param name="chromosome">the best chromosome, whose fitness is <c>GSV_BEST_FITNESS</c>.</param>
+		inline void GACALL SetBestChromosome(const GaChromosomePtr& chromosome) { _bestChromosome = chromosome; }
+
 		// Sets fitness comparator used to compare statistical values
 		/// <summary><c>SetFitnessComparator</c> method sets fitness comparator which is going to be used to compare statistical values.
 		///
@@ -276,7 +291,8 @@ namespace Common
 
 		/// <summary>This operator combines statistical values of two instances of <c>GaStatistics</c> class. Result of combining is stored in this object.
 		/// Combining is done in fallowing way:
-		///	<br> 1. Better value between two <c>GSV_BEST_FITNESS</c> values is chosen for new <c>GSV_BEST_FITNESS</c> value.
+		///	<br> 1. Better value between two <c>GSV_BEST_FITNESS</c> values is chosen for new <c>GSV_BEST_FITNESS</c> value. If both best
+		///		   chromosomes are known, the fitness comparator compares the chromosomes themselves and the better one is kept with its value.
 		///	<br> 2. Worse value between two <c>GSV_WORST_FITNESS</c> values is chosen for new <c>GSV_WORST_FITNESS</c>.
 		///	<br> 3. Two <c>GSV_TOTAL_FITNESS</c> values are summed and the sum becomes new <c>GSV_TOTAL_FITNESS</c> value.
 		///	<br> 4. Two <c>GSV_POPULATION_SIZE</c> values are summed and the sum becomes new <c>GSV_POPULATION_SIZE</c>.
@@ -47,6 +47,14 @@ namespace Algorithm
 			return algorithm.GetAlgorithmStatistics().GetCurrentGeneration() >= ( (const GaGenerationCriteriaParams&) parameters ).GetNumberOfGeneration();
 		}
 
+		// Compares the monotonic clock against the deadline given in the parameters,
+		// and returns TRUE if the deadline has passed.
+		bool GaTimeCriteria::Evaluate(const GaAlgorithm& algorithm,
+			const GaStopCriteriaParams& parameters) const
+		{
+			return std::chrono::steady_clock::now() >= ( (const GaTimeCriteriaParams&) parameters ).GetDeadline();
+		}
+
 		// Compares the state of the algorithm against given stopping condition and given paremeters,
 		// and returns TRUE if that condition is reached.
 		bool GaFitnessCriteria::Evaluate(const GaAlgorithm& algorithm,
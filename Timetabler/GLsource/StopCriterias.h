@@ -34,6 +34,7 @@
 #define __GA_STOP_CRITERIAS_H__
 
 #include <math.h>
+#include <chrono>
 #include "Platform.h"
 #include "AlgorithmOperations.h"
 
@@ -117,6 +118,79 @@ namespace Algorithm
 
 		};// END CLASS DEFINITION GaGenerationCriteria
 
+		/// <summary><c>GaTimeCriteriaParams</c> class is used by <see cref="GaTimeCriteria" /> class as parameters for the criteria.
+		/// It contains the deadline, on a monotonic clock, after which execution of algorithm should be stopped.
+		///
+		/// This class has no built-in synchronizator, so <c>LOCK_OBJECT</c> and <c>LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// No public or private methods are thread-safe.</summary>
+		class GaTimeCriteriaParams : public GaStopCriteriaParams
+		{
+
+		private:
+
+			/// <summary>Time after which algorithm should stop its execution.</summary>
+			std::chrono::steady_clock::time_point _deadline;
+
+		public:
+
+			/// <summary>This constructor initializes parameters with a deadline the given number of seconds from now.</summary>
+			/// <param name="seconds">time from now after which algorithm should stop its execution.</param>
+			GaTimeCriteriaParams(double seconds) { SetSeconds( seconds ); }
+
+			/// <summary>This constructor initializes parameters with default values. Default deadline is 30 seconds from now.</summary>
+			GaTimeCriteriaParams() { SetSeconds( 30 ); }
+
+			/// <summary>More details are given in specification of <see cref="GaParameters::Clone" /> method.</summary>
+			virtual GaParameters* GACALL Clone() const { return new GaTimeCriteriaParams( *this ); }
+
+			/// <summary>This method is not thread-safe.</summary>
+			/// <returns>Method returns time after which algorithm should stop its execution.</returns>
+			inline std::chrono::steady_clock::time_point GACALL GetDeadline() const { return _deadline; }
+
+			/// <summary><c>SetSeconds</c> method sets the deadline to the given number of seconds from now.
+			///
+			/// This method is not thread-safe.</summary>
+			/// <param name="seconds">time from now after which algorithm should stop its execution.</param>
+			inline void GACALL SetSeconds(double seconds)
+			{
+				_deadline = std::chrono::steady_clock::now() +
+					std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>( seconds ) );
+			}
+
+		};// END CLASS DEFINITION GaTimeCriteriaParams
+
+		/// <summary><c>GaTimeCriteria</c> is used to stop genetic algorithm when the monotonic clock passes specified deadline,
+		/// however many generations that takes. This stop criteria uses <see cref="GaTimeCriteriaParams" /> class as parameters.
+		///
+		/// This class has no built-in synchronizator, so <c>LOCK_OBJECT</c> and <c>LOCK_THIS_OBJECT</c> macros cannot be used with instances of this class.
+		/// Because this genetic operation is stateless all public method are thread-safe.</summary>
+		class GaTimeCriteria : public GaStopCriteria
+		{
+
+		public:
+
+			/// <summary>More details are given in specification of <see cref="GaStopCriteria::Evaluate" /> method.
+			///
+			/// This method is thread-safe.</summary>
+			GAL_API
+			virtual bool GACALL Evaluate(const GaAlgorithm& algorithm,
+				const GaStopCriteriaParams& parameters) const;
+
+			/// <summary>More details are given in specification of <see cref="GaOperation::MakeParameters" /> method.
+			///
+			/// This method is thread-safe.</summary>
+			/// <returns>Method makes new instance of <see cref="GaTimeCriteriaParams" /> class.</returns>
+			virtual GaParameters* GACALL MakeParameters() const { return new GaTimeCriteriaParams(); }
+
+			/// <summary>Any deadline is valid: one that has already passed stops the algorithm after its first generation.
+			///
+			/// More details are given in specification of <see cref="GaOperation::CheckParameters" /> method.
+			///
+			/// This method is thread-safe.</summary>
+			virtual bool GACALL CheckParameters(const GaParameters& parameters) const { return true; }
+
+		};// END CLASS DEFINITION GaTimeCriteria
+
 		/// <summary>This enumeration is used by stop criterias which are based on fitness values to specify type of comparison
 		/// of current and desired values.</summary>
 		enum GaFitnessCriteriaComparison
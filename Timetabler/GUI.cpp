@@ -10,11 +10,33 @@
 #include <functional>
 
 #include <regex>
+#include <cstdarg>
+#include <cstdio>
 
 using namespace std;
 
 #include <boost/algorithm/string/predicate.hpp>
 
+// printf onto the end of out, however long it gets
+static void appendf(string& out, const char* format, ...) {
+    
+    va_list args, copy;
+    va_start(args, format);
+    va_copy(copy, args);
+    
+    int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    
+    if (length > 0) {
+        size_t start = out.size();
+        out.resize(start + length + 1);
+        vsnprintf(&out[start], length + 1, format, args);
+        out.resize(start + length);
+    }
+    
+    va_end(args);
+}
+
 void TimetablerWebApplication::handlePathChange()
 {
     Wt::WApplication *app = Wt::WApplication::instance();
@@ -72,8 +94,11 @@ void TimetablerWebApplication::startSolve() {
 
 #endif
     
-    // Solve!
-    TimetablerInst::getInstance()->getAlgorithm()->StartSolving(false);
+    // Solve! Against the clock if there's a time limit
+    if ( TimetablerInst::getTimeLimit() > 0 )
+        TimetablerInst::getInstance()->startSolvingFor( TimetablerInst::getTimeLimit() );
+    else
+        TimetablerInst::getInstance()->getAlgorithm()->StartSolving(false);
     
     // Start the refresh timer
     _timer->start();
@@ -94,11 +119,76 @@ void TimetablerWebApplication::refreshStats() {
     cerr << "Current generation: "<<generation<<". Best fitness: "<<bestFitness<< endl;
 #endif
     
-    char out[100];
-    sprintf(out, "Gen %i, fitness %f", generation, bestFitness);
+    string out;
+    
+    // The annealers also report their speed and temperature
+    TTAnnealingAlgorithm* annealer = dynamic_cast<TTAnnealingAlgorithm*>(algorithm);
+    if ( dynamic_cast<TTTemperingAlgorithm*>(algorithm) )
+        appendf(out, "Step %i, fitness %f, %.0f moves/s, T = %.4f, %.0f%% exchanged", generation, bestFitness, annealer->getMovesPerSecond(), annealer->getTemperature(), annealer->getExchangeRate()*100);
+    else if (annealer)
+        appendf(out, "Step %i, fitness %f, %.0f moves/s, T = %.4f", generation, bestFitness, annealer->getMovesPerSecond(), annealer->getTemperature());
+    else
+        appendf(out, "Gen %i, fitness %f", generation, bestFitness);
+    
+    // How the best does on each criterion, met out of checked
+    TTBreakdown breakdown = TTFitness::breakdown( dynamic_cast<const Chromosone*>( result.GetRawPtr() ) );
+    for (int i = 0; i < TT_NUM_CRITERIA; i++) {
+        if ( !breakdown.of[i] ) continue;
+        appendf(out, "%s%s %i/%i", i ? ", " : " | ", TTFitness::getName( (TTCriterion)i ), breakdown.met[i], breakdown.of[i]);
+    }
+    
+    // Small instances may have been solved exactly
+    TTExactAlgorithm* exact = dynamic_cast<TTExactAlgorithm*>(algorithm);
+    if ( exact && exact->isOptimal() )
+        appendf(out, " (proven optimal after %lld nodes)", exact->getNodes());
+    
+    // Show how the adaptive scheduler is sharing out the operators: probability, uses and improving uses of each
+    const TTOperatorScheduler* scheduler = TimetablerInst::getInstance()->getScheduler();
+    if (scheduler) {
+        for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+            TTOperator op = (TTOperator)i;
+            if ( !scheduler->getUses(op) ) continue;
+            
+            appendf(out, " | %s %.0f%% (%lld, %lld improved)", TTOperatorScheduler::getName(op),
+                    scheduler->getProbability(op)*100, scheduler->getUses(op), scheduler->getImprovements(op));
+        }
+    }
+    
+    // And how much the crossovers' repairs are doing
+    const TTRepair* repair = TimetablerInst::getInstance()->getRepair();
+    if ( repair && repair->getRepairs() )
+        appendf(out, " | %lld children repaired (%lld of %lld stacked students moved)", repair->getRepairs(), repair->getRelocated(), repair->getConflicts());
+    
+    // And the large neighbourhood searches
+    TTIncrementalAlgorithm* incremental = dynamic_cast<TTIncrementalAlgorithm*>(algorithm);
+    if ( incremental && incremental->getSearches() )
+        appendf(out, " | %i of %i neighbourhood searches improved", incremental->getSearchesAccepted(), incremental->getSearches());
     
     _bestFitness->setText(out);
     
+    // NSGA-II's trade-offs: the criteria of the best few timetables on the Pareto front, by total score
+    const TTCrowdingReplacement* pareto = TimetablerInst::getInstance()->getPareto();
+    if (pareto) {
+        vector<GaChromosomePtr> front;
+        vector<TTObjectiveVector> objectives;
+        pareto->getFront(front, objectives);
+        
+        vector<int> order( front.size() );
+        for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+        sort( order.begin(), order.end(), [&front](int a, int b) { return front[a]->GetFitness() > front[b]->GetFitness(); } );
+        
+        string table = "Pareto front of " + to_string( front.size() ) + ":";
+        for (int i = 0; i < (int)order.size() && i < 10; i++) {
+            out.clear();
+            appendf(out, "<br/>%.4f:", front[ order[i] ]->GetFitness());
+            for (int j = 0; j < TT_NUM_OBJECTIVES; j++)
+                appendf(out, " %s %.2f", TTFitness::getName( (TTObjective)j ), objectives[ order[i] ][j]);
+            table += out;
+        }
+        
+        _paretoFront->setText(table);
+    }
+    
     // Build table
     static finishedTT* lastTT;
     finishedTT* timetable = new finishedTT(result.GetRawPtr());
@@ -181,8 +271,10 @@ void TimetablerWebApplication::pageInput() {
     // set to the correct path in case called from another function and the path is currently wrong
     this->setInternalPath("/");
     
-    // wipe any existing configuration and stop any existing algorithms
+    // wipe any existing configuration and stop any existing algorithms, keeping their population to start from next time
+    //   if warm restarts are on
     TimetablerInst::getInstance()->getAlgorithm()->StopSolving();
+    TimetablerInst::keepPopulation();
     
     // Stop the timer if it has been created
 //    if (_timer && _timer->isActive()) {
@@ -216,6 +308,7 @@ void TimetablerWebApplication::pageReady() {
     this->setInternalPath("/output");
     
     _bestFitness = new WText("");
+    _paretoFront = new WText("");
     
     TimetablerWebApplication::startSolve();
     
@@ -327,6 +420,7 @@ void TimetablerWebApplication::buildTable(finishedTT* timetable, bool tutors)
         }
         
         buttons->addWidget(_bestFitness);
+        buttons->addWidget(_paretoFront);
         buttons->addWidget(setTutor);
         buttons->addWidget(setStudent);
         buttons->addWidget(_saveConfig);
@@ -467,7 +561,11 @@ void TimetablerWebApplication::toggleState() {
         _saveConfig->enable();
         _stopButton->setText("Resume");
     } else {
-        TimetablerInst::getInstance()->getAlgorithm()->StartSolving(true);
+        // Resuming gets a fresh time limit
+        if ( TimetablerInst::getTimeLimit() > 0 )
+            TimetablerInst::getInstance()->startSolvingFor( TimetablerInst::getTimeLimit(), true );
+        else
+            TimetablerInst::getInstance()->getAlgorithm()->StartSolving(true);
         _timer->start();
 #ifdef DEBUG
         cerr << "Resuming. State is now " << TimetablerInst::getInstance()->getAlgorithm()->GetState() << endl;
@@ -76,6 +76,7 @@ private:
     WTimer* _timer;
     WText* _status;
     WText* _bestFitness;
+    WText* _paretoFront;
     bool _tableBuilt=false;
     bool _tutors=false;
     void handlePathChange();
@@ -0,0 +1,310 @@
+//
+//  TTAnnealing.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTAnnealing.h"
+#include "TTInitialization.h"
+
+#include <cmath>
+
+// Number of random moves sampled to calibrate the starting temperature
+#define CALIBRATION_MOVES 200
+
+TTAnnealingAlgorithm::TTAnnealingAlgorithm(GaPopulation* population, const TTAnnealingParams& parameters) :
+    GaMultithreadingAlgorithm(parameters),
+    _parameters(parameters),
+    _population(population),
+    _movesPerSecond(0),
+    _temperature(0),
+    _lastMoves(0)
+{
+}
+
+TTAnnealingAlgorithm::~TTAnnealingAlgorithm() {
+    clearChains();
+}
+
+void TTAnnealingAlgorithm::clearChains() {
+    for (vector<TTAnnealingChain*>::iterator it = _chains.begin(); it != _chains.end(); it++)
+        delete *it;
+    _chains.clear();
+}
+
+void TTAnnealingAlgorithm::SetAlgorithmParameters(const GaAlgorithmParams& parameters) {
+
+    // change parameters of multithreading
+    GaMultithreadingAlgorithm::SetAlgorithmParameters( parameters );
+
+    // save parameters. A change in the number of chains takes effect on the next Initialize
+    _parameters = (const TTAnnealingParams&) parameters;
+}
+
+// Make the population and start one chain per worker from its members
+void TTAnnealingAlgorithm::Initialize() {
+
+    TTPopulationInitializer::initialize( _population );
+
+    clearChains();
+
+    int size = _population->GetCurrentSize();
+
+    for (int i = 0; i < _parameters.GetNumberOfWorkers(); i++) {
+
+        TTAnnealingChain* chain = new TTAnnealingChain( GaGlobalRandomIntegerGenerator->Generate() );
+
+        chain->best = _population->GetAt( i % size ).GetChromosome();
+        chain->state = chain->best->MakeCopy(false);
+        chain->chromo = dynamic_cast<Chromosone*>( chain->state.GetRawPtr() );
+
+        const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&chain->chromo->GetParameters());
+        if ( params->getScheduler() )
+            chain->scheduler = new TTOperatorScheduler( params->getOperators() );
+
+        _chains.push_back(chain);
+    }
+
+    for (vector<TTAnnealingChain*>::iterator it = _chains.begin(); it != _chains.end(); it++) {
+        (*it)->score = (*it)->chromo->getScore();
+        calibrate(**it);
+    }
+
+    _bestChromosome = NULL;
+    _temperature = _chains[0]->temperature;
+    _movesPerSecond = 0;
+    _lastMoves = 0;
+    _lastTime = chrono::steady_clock::now();
+}
+
+void TTAnnealingAlgorithm::calibrate(TTAnnealingChain& chain) {
+
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&chain.chromo->GetParameters());
+
+    // Average the size of the worsening moves around the starting point
+    double totalWorse = 0;
+    int numWorse = 0;
+
+    for (int i = 0; i < CALIBRATION_MOVES; i++) {
+        TTOperator op = params->getOperators().choose( chain.randomDouble.Generate() );
+        TTMutation::randomMoves( chain.chromo, op, params->getChainDepth(), chain.pending, &chain.randomInteger );
+        double delta = leadingDelta( TTFitness::movesGain( chain.chromo, chain.pending ) );
+        chain.chromo->undoMoves(chain.pending);
+
+        if (delta < 0) {
+            totalWorse -= delta;
+            numWorse++;
+        }
+    }
+
+    // exp(-averageWorse / T) = initialAcceptance
+    double averageWorse = numWorse ? totalWorse / numWorse : 1.0;
+
+    chain.startTemperature = chain.temperature = -averageWorse / log( _parameters.getInitialAcceptance() );
+    chain.targetAcceptance = _parameters.getInitialAcceptance();
+    chain.sinceImprovement = 0;
+}
+
+double TTAnnealingAlgorithm::leadingDelta(const TTScore& gain) {
+
+    for (int i = 0; i < TT_NUM_TIERS; i++) {
+        long long difference = gain.tier( (TTTier)i );
+        if (difference) return (double)difference / SCORE_UNITS;
+    }
+
+    return 0;
+}
+
+void TTAnnealingAlgorithm::sweep(TTAnnealingChain& chain) {
+
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&chain.chromo->GetParameters());
+    const TTOperatorSet& operators = params->getOperators();
+    TTOperatorScheduler* scheduler = chain.scheduler;
+    int depth = params->getChainDepth();
+
+    int worse = 0, worseAccepted = 0;
+
+    for (int i = _parameters.getMovesPerStep(); i > 0; i--) {
+
+        double random = chain.randomDouble.Generate();
+        TTOperator op = scheduler ? scheduler->choose(random) : operators.choose(random);
+
+        chrono::steady_clock::time_point start;
+        if (scheduler) start = chrono::steady_clock::now();
+
+        TTMutation::randomMoves( chain.chromo, op, depth, chain.pending, &chain.randomInteger );
+        TTScore gain = TTFitness::movesGain( chain.chromo, chain.pending );
+        double delta = leadingDelta(gain);
+
+        if (scheduler)
+            scheduler->record( op, (float)delta, chrono::duration_cast<chrono::nanoseconds>( chrono::steady_clock::now() - start ).count() );
+
+        // Always accept moves that don't make things worse by the population's order. Accept worsening moves with
+        //   probability exp(delta / T), delta being the loss on the first tier they change
+        if (delta < 0) {
+            worse++;
+
+            if ( chain.randomDouble.Generate() >= exp( delta / chain.temperature ) ) {
+                chain.chromo->undoMoves(chain.pending);
+                continue;
+            }
+
+            worseAccepted++;
+        }
+
+        chain.score += gain;
+    }
+
+    chain.moves += _parameters.getMovesPerStep();
+
+    // The moves only kept chain.score up to date: bring the chromosome's own fitness and exact score into line, once
+    //   a sweep, so that it can be compared with the best
+    chain.chromo->RefreshFitness();
+    chain.score = chain.chromo->getScore();
+
+    if ( TTScoreComparator::compare( *chain.chromo, *chain.best ) > 0 ) {
+        chain.best = chain.chromo->MakeCopy(false);
+        chain.bestChanged = true;
+        chain.sinceImprovement = 0;
+    }
+    else chain.sinceImprovement++;
+
+    updateTemperature(chain, worse, worseAccepted);
+}
+
+void TTAnnealingAlgorithm::updateTemperature(TTAnnealingChain& chain, int worse, int worseAccepted) {
+
+    // Adaptive cooling: cool if we're accepting more worsening moves than the target, heat if fewer.
+    //   The target itself decays, so the chain gradually freezes at whatever rate the landscape allows
+    double ratio = worse ? (double)worseAccepted / worse : chain.targetAcceptance;
+
+    if (ratio > chain.targetAcceptance) chain.temperature *= _parameters.getCoolingRate();
+    else chain.temperature /= _parameters.getCoolingRate();
+
+    chain.targetAcceptance = max( _parameters.getFinalAcceptance(), chain.targetAcceptance * _parameters.getAcceptanceDecay() );
+
+    // Reheat if we've been stuck for too long
+    if ( _parameters.getReheatAfter() && chain.sinceImprovement >= _parameters.getReheatAfter() ) {
+        chain.temperature = chain.startTemperature * _parameters.getReheatFactor();
+        chain.targetAcceptance = max( _parameters.getFinalAcceptance(), _parameters.getInitialAcceptance() * _parameters.getReheatFactor() );
+        chain.sinceImprovement = 0;
+    }
+}
+
+void TTAnnealingAlgorithm::BeforeWorkers() {
+    // update statistics of population
+    _population->NextGeneration();
+}
+
+void TTAnnealingAlgorithm::WorkStep(int workerId) {
+    if ( workerId < (int)_chains.size() )
+        sweep( *_chains[workerId] );
+}
+
+void TTAnnealingAlgorithm::AfterWorkers() {
+
+    int size = _population->GetCurrentSize();
+    long long moves = 0;
+    vector<TTOperatorScheduler*> schedulers;
+
+    // Store each chain's best in the population if it beats what's there
+    for (int i = 0; i < (int)_chains.size(); i++) {
+        TTAnnealingChain* chain = _chains[i];
+
+        if ( chain->bestChanged && TTScoreComparator::compare( *chain->best, *_population->GetAt( i % size ).GetChromosome() ) > 0 )
+            _population->Replace( i % size, chain->best );
+        chain->bestChanged = false;
+
+        moves += chain->moves;
+        if (chain->scheduler) schedulers.push_back(chain->scheduler);
+    }
+
+    // Report the chains' operator statistics through the shared scheduler, for the GUI
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&_chains[0]->chromo->GetParameters());
+    if ( params->getScheduler() )
+        params->getScheduler()->merge(schedulers);
+
+    // update population
+    _population->EndOfGeneration();
+
+    // rais "update statistics" event
+    _observers.StatisticUpdate( _population->GetStatistics(), *this );
+
+    // get best chromosome
+    int i;
+    _population->GetBestChromosomes( &i, 0, 1 );
+    GaChromosomePtr f = _population->GetAt( i ).GetChromosome();
+
+    // best chromosome changed?
+    if( _bestChromosome.IsNULL() || *f != *_bestChromosome )
+    {
+        // raise "new best chromosome found" event
+        _bestChromosome = f;
+        _observers.NewBestChromosome( *_bestChromosome, *this );
+    }
+
+    // Update status
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    double seconds = chrono::duration<double>( now - _lastTime ).count();
+
+    if (seconds > 0) _movesPerSecond = (moves - _lastMoves) / seconds;
+    _lastMoves = moves;
+    _lastTime = now;
+
+    _temperature = _chains[0]->temperature;
+}
+
+
+TTTemperingAlgorithm::TTTemperingAlgorithm(GaPopulation* population, const TTAnnealingParams& parameters, double coldRatio) :
+    TTAnnealingAlgorithm(population, parameters),
+    _coldRatio(coldRatio),
+    _exchangeRandom( GaGlobalRandomIntegerGenerator->Generate() ),
+    _exchangeRate(0)
+{
+}
+
+// Start the chains as for annealing, then spread their temperatures from the calibrated (hot) one down to the cold one
+void TTTemperingAlgorithm::Initialize() {
+
+    TTAnnealingAlgorithm::Initialize();
+
+    double hottest = 0;
+    for (vector<TTAnnealingChain*>::iterator it = _chains.begin(); it != _chains.end(); it++)
+        hottest = max( hottest, (*it)->startTemperature );
+
+    int n = (int)_chains.size();
+    for (int i = 0; i < n; i++)
+        _chains[i]->temperature = hottest * pow( _coldRatio, n > 1 ? 1.0 - (double)i / (n - 1) : 1.0 );
+
+    _temperature = _chains[0]->temperature;
+    _exchangeRate = 0;
+}
+
+void TTTemperingAlgorithm::AfterWorkers() {
+
+    // Try exchanging neighbouring chains' timetables, alternating between the even and odd pairs each step.
+    //   Accept with probability min(1, exp( (score_j - score_i) * (1/T_i - 1/T_j) )), the scores' difference being
+    //   taken on the first tier they differ on, as for a move
+    int attempts = 0, exchanges = 0;
+
+    for (int i = GetAlgorithmStatistics().GetCurrentGeneration() % 2; i + 1 < (int)_chains.size(); i += 2) {
+        TTAnnealingChain* cold = _chains[i];
+        TTAnnealingChain* hot = _chains[i+1];
+
+        double exponent = leadingDelta( hot->score - cold->score ) * (1.0 / cold->temperature - 1.0 / hot->temperature);
+
+        attempts++;
+        if ( exponent >= 0 || _exchangeRandom.Generate() < exp(exponent) ) {
+            swap(cold->state, hot->state);
+            swap(cold->chromo, hot->chromo);
+            swap(cold->score, hot->score);
+            exchanges++;
+        }
+    }
+
+    if (attempts) _exchangeRate = (double)exchanges / attempts;
+
+    TTAnnealingAlgorithm::AfterWorkers();
+}
@@ -0,0 +1,200 @@
+//
+//  TTAnnealing.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTAnnealing__
+#define __Timetabler__TTAnnealing__
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+#include "TTChromosone.h"
+#include "TTOperatorScheduler.h"
+#include "GLSource/MultithreadingAlgorithm.h"
+
+using namespace Algorithm;
+
+// Parameters for the simulated annealing solver. Each worker thread runs its own independent chain.
+class TTAnnealingParams : public GaMultithreadingAlgorithmParams {
+
+    // Number of moves each chain tries per step. A step plays the part of a generation for the statistics and stop criteria
+    int _movesPerStep;
+
+    // Fraction of worsening moves that should be accepted at the start. Also used to pick the starting temperature
+    double _initialAcceptance;
+
+    // The target acceptance ratio decays by acceptanceDecay every step until it reaches finalAcceptance
+    double _finalAcceptance;
+    double _acceptanceDecay;
+
+    // Factor the temperature is nudged by each step to track the target acceptance ratio
+    double _coolingRate;
+
+    // Number of steps without improvement before reheating to reheatFactor times the starting temperature. 0 to disable
+    int _reheatAfter;
+    double _reheatFactor;
+
+public:
+
+    TTAnnealingParams(int numberOfChains, int movesPerStep, double initialAcceptance, double finalAcceptance, double acceptanceDecay, double coolingRate, int reheatAfter, double reheatFactor) :
+    GaMultithreadingAlgorithmParams(numberOfChains),
+    _movesPerStep(movesPerStep),
+    _initialAcceptance(initialAcceptance),
+    _finalAcceptance(finalAcceptance),
+    _acceptanceDecay(acceptanceDecay),
+    _coolingRate(coolingRate),
+    _reheatAfter(reheatAfter),
+    _reheatFactor(reheatFactor) {}
+
+    virtual GaParameters* GACALL Clone() const { return new TTAnnealingParams( *this ); }
+
+    inline int getMovesPerStep() const { return _movesPerStep; }
+    inline double getInitialAcceptance() const { return _initialAcceptance; }
+    inline double getFinalAcceptance() const { return _finalAcceptance; }
+    inline double getAcceptanceDecay() const { return _acceptanceDecay; }
+    inline double getCoolingRate() const { return _coolingRate; }
+    inline int getReheatAfter() const { return _reheatAfter; }
+    inline double getReheatFactor() const { return _reheatFactor; }
+};
+
+// State of one annealing chain. Only ever touched by its own worker, or by the control thread between steps
+struct TTAnnealingChain {
+
+    GaChromosomePtr state;  // current timetable
+    Chromosone* chromo;     // state, cast
+    GaChromosomePtr best;   // best timetable this chain has visited. Never modified once made, since it's shared with the population
+    bool bestChanged;       // has best changed since the population was last updated?
+
+    TTScore score;          // exact score of state
+
+    double temperature;
+    double startTemperature;
+    double targetAcceptance;
+    int sinceImprovement;   // steps since best last improved
+
+    long long moves;        // total moves tried
+    vector<TTMove> pending; // the move being tried, kept here to save reallocating it every time
+
+    // Each chain has its own generators so that workers don't contend on the global ones
+    GaRandomInteger randomInteger;
+    GaRandomDouble randomDouble;
+
+    // And, if the operators are adaptive, its own scheduler, so that each chain learns from its own temperature and
+    //   the workers don't contend on a shared one. NULL otherwise
+    TTOperatorScheduler* scheduler;
+
+    TTAnnealingChain(unsigned long seed) : chromo(NULL), bestChanged(false), temperature(0), startTemperature(0),
+    targetAcceptance(0), sinceImprovement(0), moves(0),
+    randomInteger(seed), randomDouble(seed + 1), scheduler(NULL) {}
+
+    ~TTAnnealingChain() { delete scheduler; }
+};
+
+// Simulated annealing over the TTMutation operators, scored with TTFitness::movesGain. Moves are accepted in the
+// population's order (see TTScoreComparator): a move that's better on the first tier it changes is always taken,
+// and one that's worse is taken with probability exp(delta / T), delta being its loss on that tier in points.
+// So trading a clash for any number of minor points counts as a worsening move, as it does to the population.
+// The population holds the best timetable found by each chain, so the GUI, observers and stop
+// criteria see this exactly as they see the GA.
+class TTAnnealingAlgorithm : public GaMultithreadingAlgorithm {
+
+protected:
+
+    TTAnnealingParams _parameters;
+
+    GaPopulation* _population;
+
+    vector<TTAnnealingChain*> _chains;
+
+    GaChromosomePtr _bestChromosome;
+
+    // Status for the GUI, updated every step
+    double _movesPerSecond;
+    double _temperature;
+    long long _lastMoves;
+    chrono::steady_clock::time_point _lastTime;
+
+public:
+
+    TTAnnealingAlgorithm(GaPopulation* population, const TTAnnealingParams& parameters);
+
+    virtual ~TTAnnealingAlgorithm();
+
+    virtual const GaAlgorithmParams& GACALL GetAlgorithmParameters() const { return _parameters; }
+
+    virtual void GACALL SetAlgorithmParameters(const GaAlgorithmParams& parameters);
+
+    virtual const GaPopulation& GACALL GetPopulation(int /*index*/) const { return *_population; }
+
+    virtual const GaStatistics& GACALL GetAlgorithmStatistics() const { return _population->GetStatistics(); }
+
+    // Moves tried per second over the last step, across all chains
+    inline double getMovesPerSecond() const { return _movesPerSecond; }
+
+    // Temperature of the first chain, in points on the tier a move changes first
+    inline double getTemperature() const { return _temperature; }
+    
+    // Fraction of attempted replica exchanges that succeeded over the last step (only used by parallel tempering)
+    virtual double getExchangeRate() const { return 0; }
+
+protected:
+
+    virtual void GACALL Initialize();
+
+    virtual void GACALL BeforeWorkers();
+
+    virtual void GACALL WorkStep(int workerId);
+
+    virtual void GACALL AfterWorkers();
+
+    // Try one step's worth of moves on the chain at its current temperature, then update its best
+    void sweep(TTAnnealingChain& chain);
+    
+    // Adjust the chain's temperature after a sweep in which it accepted worseAccepted of worse worsening moves
+    virtual void updateTemperature(TTAnnealingChain& chain, int worse, int worseAccepted);
+
+    // Pick the chain's starting temperature so that worsening moves are accepted with probability initialAcceptance
+    void calibrate(TTAnnealingChain& chain);
+
+    // What a gain is worth to the Metropolis rule: the change on the first tier it changes, in points. 0 if none
+    static double leadingDelta(const TTScore& gain);
+
+    void clearChains();
+};
+
+// Parallel tempering (replica exchange): one chain per worker, each at a fixed temperature on a geometric
+// ladder. Chains anneal independently between steps and neighbouring chains swap timetables at the end
+// of each step, which is the only point at which they synchronise. Chain 0 is the coldest.
+class TTTemperingAlgorithm : public TTAnnealingAlgorithm {
+    
+    // Coldest temperature as a fraction of the hottest
+    double _coldRatio;
+    
+    // Generator for the exchanges, only used by the control thread
+    GaRandomDouble _exchangeRandom;
+    
+    double _exchangeRate;
+    
+public:
+    
+    // parameters' cooling and reheating settings are ignored. initialAcceptance sets the hottest temperature
+    TTTemperingAlgorithm(GaPopulation* population, const TTAnnealingParams& parameters, double coldRatio);
+    
+    virtual double getExchangeRate() const { return _exchangeRate; }
+    
+protected:
+    
+    virtual void GACALL Initialize();
+    
+    virtual void GACALL AfterWorkers();
+    
+    // Temperatures are fixed
+    virtual void updateTemperature(TTAnnealingChain& /*chain*/, int /*worse*/, int /*worseAccepted*/) {}
+};
+
+#endif /* defined(__Timetabler__TTAnnealing__) */
@@ -0,0 +1,637 @@
+//
+//  TTBranchAndBound.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTBranchAndBound.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+// Number of subgradient steps taken to price the slots before searching
+#define PRICE_ITERATIONS 50
+
+TTBranchAndBound::TTBranchAndBound(const Chromosone* chromo, const vector<Student*>& freed, const vector<int>& region) :
+    _prevLoaded( TTFitness::scoresStability() ),
+    _bestScore(0),
+    _elsewhere(NULL),
+    _elsewhereScore(0),
+    _elsewhereKnown(false),
+    _sinceElsewhere(0),
+    _cancel(NULL),
+    _nodes(0),
+    _maxNodes(0),
+    _cancelled(false),
+    _complete(false)
+{
+    Configuration& config = Configuration::getInstance();
+    const TTWeights& weights = config.getWeights();
+    const vector<list<Student*> >& slots = chromo->GetSlots();
+
+    // Scores as they're worked out, to be turned into keys once the tiers are weighted
+    vector<TTScore> values;
+    TTScore fixedScore, currentScore;
+    long long prevUnits = weights.units[TT_CRIT_STABILITY];
+
+    // The freed students' slots, and whichever of the others are empty
+    for (vector<Student*>::const_iterator it = freed.begin(); it != freed.end(); it++)
+        _region.push_back( chromo->getSlot(*it) );
+    for (vector<int>::const_iterator it = region.begin(); it != region.end(); it++)
+        if ( slots[*it].empty() ) _region.push_back(*it);
+
+    sort( _region.begin(), _region.end() );
+    _region.erase( unique( _region.begin(), _region.end() ), _region.end() );
+
+    int numRegion = (int)_region.size();
+
+    // Gather the freed students by person
+    hash_map<int, int> groupOfBase;
+    vector<vector<Student*> > people;
+
+    for (vector<Student*>::const_iterator it = freed.begin(); it != freed.end(); it++) {
+        hash_map<int, int>::iterator found = groupOfBase.find( (*it)->getBaseID() );
+        if ( found == groupOfBase.end() ) {
+            groupOfBase[ (*it)->getBaseID() ] = (int)people.size();
+            people.push_back( vector<Student*>() );
+            people.back().push_back(*it);
+        }
+        else people[ (*found).second ].push_back(*it);
+    }
+
+    // Place the most constrained people first: those who can do the fewest region slots for the number of interviews they have
+    vector<pair<double, int> > byFreedom;
+    for (int g = 0; g < (int)people.size(); g++) {
+        const StudentConstraints& constraints = config.getConstraints( people[g].front() );
+        int feasible = 0;
+        for (int r = 0; r < numRegion; r++)
+            if ( constraints.canDoSlot[ _region[r] ] ) feasible++;
+        byFreedom.push_back( make_pair( (double)feasible / people[g].size(), g ) );
+    }
+    sort( byFreedom.begin(), byFreedom.end() );
+
+    for (vector<pair<double, int> >::iterator it = byFreedom.begin(); it != byFreedom.end(); it++) {
+
+        const vector<Student*>& person = people[ (*it).second ];
+        Group group;
+
+        for (vector<Student*>::const_iterator s = person.begin(); s != person.end(); s++) {
+            group.freed.push_back( (int)_students.size() );
+            _groupOf.push_back( (int)_groups.size() );
+            _students.push_back(*s);
+
+            for (int r = 0; r < numRegion; r++)
+                values.push_back( unaryScore( *s, _region[r] ) );
+        }
+
+        // Their interviews that aren't being moved. Everything the search can change about this person's
+        //   score is counted in the group, so score all their interviews as they stand too
+        const vector<Student*>& siblings = config.getConstraints( person.front() ).siblings;
+        for (vector<Student*>::const_iterator s = siblings.begin(); s != siblings.end(); s++) {
+            bool essential;
+            TTFitness::scoreStudent( chromo, *s, chromo->getSlot(*s), essential, &currentScore );
+
+            if ( find( person.begin(), person.end(), *s ) != person.end() ) continue;
+
+            int slot = chromo->getSlot(*s);
+            group.fixedSlots.push_back(slot);
+            fixedScore += unaryScore( *s, slot );
+            if ( slots[slot].size() > 1 ) fixedScore.units[TT_OBJ_OVERLAP] -= weights.units[TT_CRIT_OVERLAP];
+        }
+
+        _groups.push_back(group);
+        _where.resize( max( _where.size(), siblings.size() ) );
+    }
+
+    int numStudents = (int)_students.size();
+
+    // The previous solution's scores for each region slot, as scorePrevSlot. A slot counts as matching until someone's put
+    //   in it, so each student's value for a slot also carries the change in the slot's score from putting them there
+    vector<long long> prevEmpty( numRegion );
+
+    if (_prevLoaded) {
+        const vector<list<int> >& prevSolution = config.getPrevSolution();
+
+        for (int r = 0; r < numRegion; r++) {
+            int slot = _region[r];
+
+            if ( slot >= (int)prevSolution.size() ) {
+                prevEmpty[r] = prevUnits;
+                for (int i = 0; i < numStudents; i++)
+                    values[ i * numRegion + r ].units[TT_OBJ_STABILITY] -= prevUnits;
+                continue;
+            }
+
+            const list<int>& prevSlot = prevSolution[slot];
+            prevEmpty[r] = prevSlot.empty() ? prevUnits : 0;
+
+            for (int i = 0; i < numStudents; i++)
+                if ( find( prevSlot.begin(), prevSlot.end(), _students[i]->getBaseID() ) == prevSlot.end() )
+                    values[ i * numRegion + r ].units[TT_OBJ_STABILITY] -= prevUnits;
+        }
+    }
+
+    // What the slots involved score now
+    if (_prevLoaded)
+        for (int r = 0; r < numRegion; r++)
+            TTFitness::scorePrevSlot( chromo, _region[r], &currentScore );
+
+    // Everything from here on is in keys
+    _ranked = setTierWeights( values, fixedScore );
+
+    for (vector<TTScore>::const_iterator it = values.begin(); it != values.end(); it++)
+        _value.push_back( key(*it) );
+    for (int r = 0; r < numRegion; r++)
+        _prevEmpty.push_back( key( TT_CRIT_STABILITY, prevEmpty[r] ) );
+
+    _prevScore = key( TT_CRIT_STABILITY, prevUnits );
+    _engagementsScore = key( TT_CRIT_ENGAGEMENTS, weights.units[TT_CRIT_ENGAGEMENTS] );
+    _groupingScore = key( TT_CRIT_GROUPING, weights.units[TT_CRIT_GROUPING] );
+    _pairingScore = key( TT_CRIT_PAIRING, weights.units[TT_CRIT_PAIRING] );
+    _fixedScore = key(fixedScore);
+    _currentScore = key(currentScore);
+
+    // Interviews of the same person with the same scores everywhere can be swapped without changing anything
+    for (int i = 0; i < numStudents; i++)
+        _sameAsPrevious.push_back( i > 0 && _groupOf[i] == _groupOf[i-1] &&
+                                   equal( _value.begin() + i * numRegion, _value.begin() + (i+1) * numRegion, _value.begin() + (i-1) * numRegion ) );
+
+    setPrices( vector<long long>( numRegion ) );
+}
+
+bool TTBranchAndBound::setTierWeights(const vector<TTScore>& values, const TTScore& fixed) {
+
+    const TTWeights& weights = Configuration::getInstance().getWeights();
+    int numRegion = (int)_region.size();
+    int numStudents = (int)_students.size();
+
+    // The most each tier of any score the search adds up could be, either way: the best or worst slot of every freed
+    //   student, every person's own terms at their most, every slot matching the previous solution, and what's fixed.
+    //   Any two of those scores are within twice that of each other
+    long long span[TT_NUM_TIERS], step[TT_NUM_TIERS];
+    for (int t = 0; t < TT_NUM_TIERS; t++) span[t] = step[t] = 0;
+
+    // Everything in a tier is a multiple of every score that goes into it
+    auto addStep = [&step](const TTScore& score) {
+        for (int t = 0; t < TT_NUM_TIERS; t++) {
+            long long a = llabs( score.tier( (TTTier)t ) ), b = step[t];
+            while (b) { long long r = a % b; a = b; b = r; }
+            step[t] = a;
+        }
+    };
+    auto addSpan = [&span](const TTScore& score, long long times) {
+        for (int t = 0; t < TT_NUM_TIERS; t++) span[t] += times * llabs( score.tier( (TTTier)t ) );
+    };
+
+    for (int i = 0; i < numStudents; i++) {
+        long long most[TT_NUM_TIERS] = {};
+        for (int r = 0; r < numRegion; r++) {
+            const TTScore& value = values[ i * numRegion + r ];
+            addStep(value);
+            for (int t = 0; t < TT_NUM_TIERS; t++) most[t] = max( most[t], llabs( value.tier( (TTTier)t ) ) );
+        }
+        for (int t = 0; t < TT_NUM_TIERS; t++) span[t] += most[t];
+    }
+
+    TTScore engagements, grouping, pairing, stability;
+    engagements.units[ TTFitness::getObjective(TT_CRIT_ENGAGEMENTS) ] = weights.units[TT_CRIT_ENGAGEMENTS];
+    grouping.units[ TTFitness::getObjective(TT_CRIT_GROUPING) ] = weights.units[TT_CRIT_GROUPING];
+    pairing.units[ TTFitness::getObjective(TT_CRIT_PAIRING) ] = weights.units[TT_CRIT_PAIRING];
+    stability.units[TT_OBJ_STABILITY] = weights.units[TT_CRIT_STABILITY];
+
+    addStep(engagements);
+    addStep(grouping);
+    addStep(pairing);
+    addStep(stability);
+    addStep(fixed);
+
+    for (vector<Group>::const_iterator it = _groups.begin(); it != _groups.end(); it++) {
+        long long n = it->freed.size() + it->fixedSlots.size();
+        addSpan( engagements, n );
+        addSpan( grouping, n * (n - 1) );
+        addSpan( pairing, n );
+    }
+    if (_prevLoaded) addSpan( stability, numRegion );
+    addSpan( fixed, 1 );
+
+    // Each tier outweighs the most all the tiers below it could differ by. The bound adds up a score, the priced
+    //   values of every person and the price of every slot, so leave room for that many keys at their biggest
+    long long limit = LLONG_MAX / 4 / ( numRegion + _groups.size() + 2 );
+    long long weight = 1;
+    bool fits = true;
+
+    for (int t = TT_NUM_TIERS - 1; t >= 0; t--) {
+        if (!step[t]) step[t] = 1;
+        _tierStep[t] = step[t];
+        _tierWeight[t] = weight;
+
+        long long range = 2 * ( span[t] / step[t] ) + 1;
+        if ( weight > limit / range ) {
+            fits = false;
+            break;
+        }
+        weight *= range;
+    }
+
+    _maxKey = weight;
+
+    // Rather than rank wrongly, the search won't run at all
+    if (!fits)
+        for (int t = 0; t < TT_NUM_TIERS; t++) {
+            _tierStep[t] = 1;
+            _tierWeight[t] = 0;
+        }
+
+    return fits;
+}
+
+long long TTBranchAndBound::key(const TTScore& score) const {
+    long long sum = 0;
+    for (int t = 0; t < TT_NUM_TIERS; t++) sum += _tierWeight[t] * ( score.tier( (TTTier)t ) / _tierStep[t] );
+    return sum;
+}
+
+long long TTBranchAndBound::key(TTCriterion criterion, long long units) const {
+    TTScore score;
+    score.units[ TTFitness::getObjective(criterion) ] = units;
+    return key(score);
+}
+
+void TTBranchAndBound::readElsewhere() {
+    _sinceElsewhere = 0;
+
+    // It only ever goes up, so the last key read still stands if there's nothing newer
+    TTScore score;
+    if ( _elsewhere->get(score) ) {
+        _elsewhereScore = key(score);
+        _elsewhereKnown = true;
+    }
+}
+
+TTScore TTBranchAndBound::unaryScore(Student* student, int slot) {
+
+    Configuration& config = Configuration::getInstance();
+    const StudentConstraints& constraints = config.getConstraints(student);
+    const TTWeights& weights = config.getWeights();
+
+    int tutor = slot / SLOTS_IN_DAY;
+
+    // Alone in the slot, as scoreStudent adds it up
+    TTScore score;
+    score.units[TT_OBJ_OVERLAP] = weights.units[TT_CRIT_OVERLAP];
+
+    float proficiency = constraints.proficiency[tutor];
+    if (proficiency >= 0) score.units[TT_OBJ_PROFICIENCY] = (long long)( proficiency * weights.units[TT_CRIT_PROFICIENCY] + 0.5f );
+
+    if ( config.tutorCanDoSlot(slot) ) score.units[TT_OBJ_AVAILABILITY] += weights.units[TT_CRIT_TUTOR_AVAILABILITY];
+
+    if ( constraints.canDoTime[ slot % SLOTS_IN_DAY ] ) score.units[TT_OBJ_AVAILABILITY] += weights.units[TT_CRIT_STUDENT_AVAILABILITY];
+
+    if ( !constraints.prevTutor[tutor] ) score.units[TT_OBJ_PREV_TUTOR] = weights.units[TT_CRIT_PREV_TUTOR];
+
+    return score;
+}
+
+long long TTBranchAndBound::groupScore(int group) const {
+
+    const Group& g = _groups[group];
+
+    // Where each interview is, or -1 if it hasn't been placed yet
+    int* where = &_where[0];
+    int n = 0;
+
+    for (vector<int>::const_iterator it = g.freed.begin(); it != g.freed.end(); it++)
+        where[n++] = _placed[*it] < 0 ? -1 : _region[ _placed[*it] ];
+    for (vector<int>::const_iterator it = g.fixedSlots.begin(); it != g.fixedSlots.end(); it++)
+        where[n++] = *it;
+
+    long long score = 0;
+
+    for (int a = 0; a < n; a++) {
+        bool clash = false, paired = false;
+        int samegroup = 0;
+
+        for (int b = 0; b < n; b++) {
+            if (a == b) continue;
+
+            if (where[a] < 0 || where[b] < 0) {
+                samegroup++;
+                continue;
+            }
+
+            int timeA = where[a] % SLOTS_IN_DAY, timeB = where[b] % SLOTS_IN_DAY;
+
+            if (timeA == timeB) clash = true;
+            if ( sessionOf(timeA) == sessionOf(timeB) ) samegroup++;
+            if (where[a] / SLOTS_IN_DAY == where[b] / SLOTS_IN_DAY) paired = true;
+        }
+
+        if (!clash) score += _engagementsScore;
+        score += samegroup * _groupingScore;
+        if (!paired) score += _pairingScore;
+    }
+
+    return score;
+}
+
+long long TTBranchAndBound::bestFree(int i) const {
+
+    int numRegion = (int)_region.size();
+    const vector<int>& order = _order[i];
+
+    for (int k = 0; k < numRegion; k++)
+        if ( !_taken[ order[k] ] ) return _priced[ i * numRegion + order[k] ];
+
+    return 0;
+}
+
+bool TTBranchAndBound::solve(long long maxNodes, const TTKnownScore* elsewhere, const atomic<bool>* cancel) {
+
+    int numStudents = (int)_students.size();
+    int numRegion = (int)_region.size();
+    int numGroups = (int)_groups.size();
+
+    _placed.assign( numStudents, -1 );
+    _taken.assign( numRegion, false );
+    _best.clear();
+    _bestScore = _currentScore;
+    _elsewhere = elsewhere;
+    _elsewhereKnown = false;
+    _cancel = cancel;
+    _nodes = 0;
+    _maxNodes = maxNodes;
+    _cancelled = false;
+    _complete = false;
+
+    // Nowhere near enough room: there's no placement with one student to a slot. Or too much to rank exactly
+    if (numRegion < numStudents || !_ranked) return false;
+
+    if (_elsewhere) readElsewhere();
+
+    _levelBound.assign( numGroups + 1, vector<long long>( numGroups ) );
+    _levelPlacement.assign( numGroups + 1, vector<vector<int> >( numGroups ) );
+
+    // Nothing placed yet: every slot could still score for matching the previous solution
+    long long score = _fixedScore;
+    if (_prevLoaded) score += _prevScore * numRegion;
+
+    if ( optimisePrices(score) > threshold() )
+        search( 0, score );
+
+    _complete = !givenUp();
+
+    return !_best.empty();
+}
+
+void TTBranchAndBound::search(int group, long long score) {
+
+    ++_nodes;
+    if ( givenUp() ) return;
+
+    int numRegion = (int)_region.size();
+    int numGroups = (int)_groups.size();
+
+    if (group == numGroups) {
+
+        // The slots left empty score for matching the previous solution only if it had them empty too
+        if (_prevLoaded)
+            for (int r = 0; r < numRegion; r++)
+                if ( !_taken[r] ) score -= _prevScore - _prevEmpty[r];
+
+        if ( score > threshold() ) {
+            _bestScore = score;
+            _best = _placed;
+        }
+        return;
+    }
+
+    // The best each person still to be placed could do on their own with the slots left. A person's best from
+    //   the last level still stands unless the last person took one of the slots it used
+    vector<long long>& bound = _levelBound[group];
+    vector<vector<int> >& placement = _levelPlacement[group];
+
+    long long rest = 0;
+
+    for (int q = group; q < numGroups; q++) {
+
+        bool stale = group == 0;
+
+        if (!stale) {
+            bound[q] = _levelBound[group-1][q];
+            placement[q] = _levelPlacement[group-1][q];
+
+            const vector<int>& taken = _groups[group-1].freed;
+            for (vector<int>::const_iterator it = taken.begin(); it != taken.end() && !stale; it++)
+                stale = find( placement[q].begin(), placement[q].end(), _placed[*it] ) != placement[q].end();
+        }
+
+        if (stale) bound[q] = isolatedBest( q, placement[q] );
+
+        rest += bound[q];
+    }
+
+    if ( score + _freePrice + rest <= threshold() ) return;
+
+    placeGroup( group, 0, score, rest - bound[group] );
+}
+
+void TTBranchAndBound::placeGroup(int group, int k, long long score, long long rest) {
+
+    const vector<int>& freed = _groups[group].freed;
+
+    if ( k == (int)freed.size() ) {
+        search( group + 1, score + groupScore(group) );
+        return;
+    }
+
+    ++_nodes;
+    if ( givenUp() ) return;
+
+    // What this person could still score, on top of everyone after them
+    long long bound = score + groupScore(group) + _freePrice + rest;
+    for (int j = k; j < (int)freed.size(); j++)
+        bound += bestFree( freed[j] );
+
+    if ( bound <= threshold() ) return;
+
+    int numRegion = (int)_region.size();
+    int i = freed[k];
+
+    // Interchangeable interviews go in increasing slot order
+    int after = _sameAsPrevious[i] ? _placed[i-1] : -1;
+
+    const vector<int>& order = _order[i];
+
+    for (int n = 0; n < numRegion; n++) {
+        int r = order[n];
+        if ( _taken[r] || r <= after ) continue;
+
+        _taken[r] = true;
+        _placed[i] = r;
+        _freePrice -= _price[r];
+
+        placeGroup( group, k + 1, score + _value[ i * numRegion + r ], rest );
+
+        _taken[r] = false;
+        _placed[i] = -1;
+        _freePrice += _price[r];
+
+        if ( givenUp() ) return;
+    }
+}
+
+long long TTBranchAndBound::isolatedBest(int group, vector<int>& placement) {
+
+    long long best = LLONG_MIN;
+    placement.clear();
+
+    isolatedSearch( group, 0, 0, best, placement );
+
+    return best;
+}
+
+void TTBranchAndBound::isolatedSearch(int group, int k, long long score, long long& best, vector<int>& placement) {
+
+    const vector<int>& freed = _groups[group].freed;
+
+    if ( k == (int)freed.size() ) {
+        score += groupScore(group);
+
+        if (score > best) {
+            best = score;
+            placement.clear();
+            for (vector<int>::const_iterator it = freed.begin(); it != freed.end(); it++)
+                placement.push_back( _placed[*it] );
+        }
+        return;
+    }
+
+    _nodes++;
+
+    long long bound = score + groupScore(group);
+    for (int j = k; j < (int)freed.size(); j++)
+        bound += bestFree( freed[j] );
+
+    if (bound <= best) return;
+
+    int numRegion = (int)_region.size();
+    int i = freed[k];
+    int after = _sameAsPrevious[i] ? _placed[i-1] : -1;
+
+    const vector<int>& order = _order[i];
+
+    for (int n = 0; n < numRegion; n++) {
+        int r = order[n];
+        if ( _taken[r] || r <= after ) continue;
+
+        _taken[r] = true;
+        _placed[i] = r;
+
+        isolatedSearch( group, k + 1, score + _priced[ i * numRegion + r ], best, placement );
+
+        _taken[r] = false;
+        _placed[i] = -1;
+    }
+}
+
+void TTBranchAndBound::setPrices(const vector<long long>& prices) {
+
+    int numStudents = (int)_students.size();
+    int numRegion = (int)_region.size();
+
+    _price = prices;
+    _freePrice = 0;
+    for (int r = 0; r < numRegion; r++) _freePrice += _price[r];
+
+    _priced.resize( _value.size() );
+    _order.resize( numStudents );
+
+    for (int i = 0; i < numStudents; i++) {
+        for (int r = 0; r < numRegion; r++)
+            _priced[ i * numRegion + r ] = _value[ i * numRegion + r ] - _price[r];
+
+        vector<int>& order = _order[i];
+        order.resize( numRegion );
+        for (int r = 0; r < numRegion; r++) order[r] = r;
+
+        const long long* priced = &_priced[ i * numRegion ];
+        stable_sort( order.begin(), order.end(), [priced](int a, int b) { return priced[a] > priced[b]; } );
+    }
+}
+
+long long TTBranchAndBound::optimisePrices(long long score) {
+
+    int numRegion = (int)_region.size();
+    int numGroups = (int)_groups.size();
+
+    vector<long long> prices( numRegion ), bestPrices( numRegion );
+    vector<int> usage( numRegion );
+    vector<int> placement;
+
+    long long bestBound = LLONG_MAX;
+    double step = 0.25;
+    int sinceImprovement = 0;
+
+    for (int iteration = 0; iteration < PRICE_ITERATIONS; iteration++) {
+
+        setPrices(prices);
+
+        // Everyone's best on their own at these prices, and how many people that puts in each slot
+        long long bound = score + _freePrice;
+        usage.assign( numRegion, 0 );
+
+        for (int g = 0; g < numGroups; g++) {
+            bound += isolatedBest( g, placement );
+            for (vector<int>::iterator it = placement.begin(); it != placement.end(); it++)
+                usage[*it]++;
+        }
+
+        if (bound < bestBound) {
+            bestBound = bound;
+            bestPrices = prices;
+            sinceImprovement = 0;
+        }
+        else if (++sinceImprovement % 5 == 0) step /= 2;
+
+        // Nothing left to prove
+        long long target = threshold();
+        if (bestBound <= target) break;
+
+        // Put up the price of slots more than one person wants and bring down the price of those nobody does
+        double norm = 0;
+        for (int r = 0; r < numRegion; r++) {
+            int excess = usage[r] - 1;
+            if (excess < 0 && prices[r] <= 0) excess = 0;
+            usage[r] = excess;
+            norm += excess * excess;
+        }
+
+        // Nobody wants the same slot, so prices can't do any better
+        if (norm == 0) break;
+
+        // Any prices give a valid bound, so they're rounded to whole keys, and kept to what the keys leave room for
+        double size = step * (bound - target) / norm;
+        for (int r = 0; r < numRegion; r++)
+            prices[r] = min( _maxKey, max( 0LL, prices[r] + llround( size * usage[r] ) ) );
+    }
+
+    setPrices(bestPrices);
+
+    return bestBound;
+}
+
+void TTBranchAndBound::apply(Chromosone* chromo) const {
+
+    if ( _best.empty() ) return;
+
+    for (int i = 0; i < (int)_students.size(); i++) {
+        int from = chromo->getSlot( _students[i] );
+        int to = _region[ _best[i] ];
+        if (from != to) chromo->applyMove( TTMove( _students[i], from, to ) );
+    }
+
+    chromo->RefreshFitness();
+}
@@ -0,0 +1,214 @@
+//
+//  TTBranchAndBound.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTBranchAndBound__
+#define __Timetabler__TTBranchAndBound__
+
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "TTChromosone.h"
+
+// How many times the search checks whether it's given up between reads of the score elsewhere
+#define ELSEWHERE_INTERVAL 1024
+
+// The score of the best timetable known of by some other means, for a search of the whole timetable to beat. It's
+//   raised from one thread while searches read it from others, so all of it changes together
+class TTKnownScore {
+    
+    mutable mutex _mutex;
+    TTScore _score;
+    bool _known;
+    
+public:
+    
+    TTKnownScore() : _known(false) {}
+    
+    inline void clear() {
+        lock_guard<mutex> lock(_mutex);
+        _known = false;
+    }
+    
+    // Raise it to score, if that's better
+    inline void raise(const TTScore& score) {
+        lock_guard<mutex> lock(_mutex);
+        if ( !_known || TTScoreComparator::compare( score, _score ) > 0 ) _score = score;
+        _known = true;
+    }
+    
+    // Returns false if nothing's known yet
+    inline bool get(TTScore& score) const {
+        lock_guard<mutex> lock(_mutex);
+        score = _score;
+        return _known;
+    }
+};
+
+// Exact depth-first branch and bound over where a set of freed students go, with everyone else left where they are.
+// The freed students are placed a person (baseID) at a time, at most one interview to a slot, into region slots
+// that nobody else is in. The bound at each node is the exact score of the people already placed, plus the best
+// each person still to come could do on their own with the slots that are left. That is found by a small search
+// of its own over the dense constraint tables, and only redone when someone takes a slot it relied on. People
+// competing for the same slots are accounted for by Lagrangian relaxation: each slot has a price, chosen at the
+// root, which everyone pays for using it and which the bound gets back for every slot left free. Interviews of
+// the same person are interchangeable, so they're only ever placed in increasing slot order.
+//
+// The scoring is TTFitness::scoreStudent's and scorePrevSlot's, split into the part that depends on the student's
+// own slot (unaryScore) and the part that depends on their other interviews (groupScore). Keep them in step.
+// Placements are ranked as TTScoreComparator ranks timetables, tier by tier. To keep the search working on single
+// numbers, every score is turned into a key: the sum of its tiers, each weighted by more than all the tiers below it
+// could ever differ by among the students and slots the search can change. Keys add up exactly in integers and
+// compare the same way as the scores, so the bounds stay exact too.
+class TTBranchAndBound {
+
+    // One person's interviews: the freed ones (indices into _students) and the slots of the ones staying put
+    struct Group {
+        vector<int> freed;
+        vector<int> fixedSlots;
+    };
+
+    vector<Student*> _students;     // the freed students, in the order they're placed
+    vector<int> _region;            // the slots they can go in, ascending
+    vector<int> _groupOf;           // which group each freed student is in
+    vector<bool> _sameAsPrevious;   // whether each freed student is interchangeable with the one placed before it
+    vector<Group> _groups;
+
+    // Keys are the sum of each tier's score divided by its step, times its weight. The step is what every score in
+    //   the tier is a multiple of, which keeps the keys small. _ranked is false if the keys wouldn't fit in a long long
+    long long _tierWeight[TT_NUM_TIERS];
+    long long _tierStep[TT_NUM_TIERS];
+    long long _maxKey;              // no score the search adds up has a key further from 0 than this
+    bool _ranked;
+
+    // What each freed student adds by going in each region slot: their unaryScore, and the change in the slot's
+    //   scorePrevSlot. Indexed by student * region size + region index
+    vector<long long> _value;
+
+    // scorePrevSlot of each region slot if it's left empty
+    vector<long long> _prevEmpty;
+
+    // Lagrangian prices on the region slots, which stand in for the rule of one student to a slot when bounding.
+    //   _priced is _value less the slot's price, and each student's _order lists the region best priced value first
+    vector<long long> _price;
+    vector<long long> _priced;
+    vector<vector<int> > _order;
+
+    bool _prevLoaded;               // whether slots are scored on matching the previous solution
+    long long _prevScore;           // and what for
+
+    // The keys of groupScore's criteria
+    long long _engagementsScore;
+    long long _groupingScore;
+    long long _pairingScore;
+
+    // Unary scores of the freed students' interviews that stay put
+    long long _fixedScore;
+
+    // Score of the students and slots the search can affect, as the timetable stands
+    long long _currentScore;
+
+    // Search state
+    vector<int> _placed;            // region index of each freed student, or -1
+    vector<bool> _taken;            // by region index
+    long long _freePrice;           // total price of the slots not taken
+    mutable vector<int> _where;     // groupScore's workspace, big enough for anyone's interviews
+
+    // For each level of the search (number of people placed), the best each person still to be placed could
+    //   do on their own at priced values with the slots left, and where that puts them
+    vector<vector<long long> > _levelBound;
+    vector<vector<vector<int> > > _levelPlacement;
+    vector<int> _best;              // best placement found
+    long long _bestScore;
+    const TTKnownScore* _elsewhere;
+    long long _elsewhereScore;      // its key when last read, if _elsewhereKnown
+    bool _elsewhereKnown;
+    int _sinceElsewhere;            // nodes since it was last read
+    const atomic<bool>* _cancel;
+    long long _nodes;
+    long long _maxNodes;
+    bool _cancelled;
+    bool _complete;
+
+public:
+
+    // Set up the search for placing freed among region (in any order) in chromo. Every student sharing a slot
+    //   with a freed student must be freed too, and region slots holding anyone else are ignored.
+    //   The freed students' own slots are always part of the region
+    TTBranchAndBound(const Chromosone* chromo, const vector<Student*>& freed, const vector<int>& region);
+
+    // Search, visiting at most maxNodes nodes (0 for no limit). Returns true if it found a placement
+    //   ranked better than the current one. If elsewhere is given, it's the score of the whole timetable known of by
+    //   some other means, which may go up during the search: placements that can't beat it aren't looked for either.
+    //   If cancel is given, the search gives up as soon as it's set, as if out of nodes
+    bool solve(long long maxNodes, const TTKnownScore* elsewhere = NULL, const atomic<bool>* cancel = NULL);
+
+    // Did the last solve search the whole tree? If so the best placement it found is optimal, or if it didn't find
+    //   one, nothing beats the current placement or the score elsewhere
+    inline bool isComplete() const { return _complete; }
+
+    inline long long getNodes() const { return _nodes; }
+
+    // Move the freed students to the best placement found. chromo must still place them as the one the search was set up from
+    void apply(Chromosone* chromo) const;
+
+    // The part of TTFitness::scoreStudent that depends only on the student's own slot, assuming they're alone in it
+    static TTScore unaryScore(Student* student, int slot);
+
+private:
+
+    // Work out the tiers' steps and weights from the scores the search adds up: values as _value, the rest as
+    //   _fixedScore. Returns false if the keys could get too big for a long long
+    bool setTierWeights(const vector<TTScore>& values, const TTScore& fixed);
+
+    long long key(const TTScore& score) const;
+
+    // The key of a score of units in criterion
+    long long key(TTCriterion criterion, long long units) const;
+
+    // What a placement has to score to be worth finding
+    inline long long threshold() const {
+        return _elsewhereKnown ? max( _bestScore, _elsewhereScore ) : _bestScore;
+    }
+
+    // Has the search run out of nodes or been cancelled? Also keeps up with the score elsewhere
+    inline bool givenUp() {
+        if ( _elsewhere && ++_sinceElsewhere >= ELSEWHERE_INTERVAL ) readElsewhere();
+        if ( _cancel && _cancel->load( memory_order_relaxed ) ) _cancelled = true;
+        return _cancelled || ( _maxNodes && _nodes > _maxNodes );
+    }
+
+    void readElsewhere();
+
+    // Place group onwards, given the score of the groups before it
+    void search(int group, long long score);
+
+    // Place the group's kth freed interview onwards. rest is the bound for the groups after it
+    void placeGroup(int group, int k, long long score, long long rest);
+
+    // The best the group could score on its own in the slots nobody has taken, and where that puts its freed interviews
+    long long isolatedBest(int group, vector<int>& placement);
+    void isolatedSearch(int group, int k, long long score, long long& best, vector<int>& placement);
+
+    // Grouping, clash and pairing scores for the group's interviews as placed so far, counting any criterion
+    //   that an unplaced interview could still meet as met
+    long long groupScore(int group) const;
+
+    // The best priced value student i could get from a slot nobody has taken
+    long long bestFree(int i) const;
+
+    // Set the slots' prices, and the priced values and orders that go with them
+    void setPrices(const vector<long long>& prices);
+
+    // Choose prices by subgradient descent to make the bound at the root, given the score with nothing placed, as low
+    //   as possible. Returns that bound
+    long long optimisePrices(long long score);
+};
+
+#endif /* defined(__Timetabler__TTBranchAndBound__) */
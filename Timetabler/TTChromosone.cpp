@@ -8,7 +8,17 @@
 
 #include "TTChromosone.h"
 #include "TimetablerInst.h"
+#include "TTOperatorScheduler.h"
+#include "TTMatching.h"
+#include "TTRepair.h"
 #include <ext/hash_map>
+#include <chrono>
+#include <cmath>
+
+// Add s to v if it's not already there. The lists involved are short, so a linear search is fine
+template <class T> static inline void addUnique(vector<T>& v, T s) {
+    if ( find(v.begin(), v.end(), s) == v.end() ) v.push_back(s);
+}
 
 void dumpHash (hash_map<Student*, int> in){
     for (hash_map<Student*, int>::iterator it = in.begin() ; it != in.end(); it++) {
@@ -20,15 +30,25 @@ Chromosone::Chromosone(GaChromosomeDomainBlock<list<Student*> >* configBlock) :
     GaMultiValueChromosome<list<Student*> >(configBlock)
 {
     _values.resize( SLOTS_IN_DAY * Configuration::getInstance().numTutors() );
+    
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&GetParameters());
+    _mutationProbability = params->GetMutationProbability();
+    _mutationSize = params->GetMutationSize();
+    _probSwap = params->getProbSwap();
 }
 
+// The mutation parameters are always copied, since a child starts off with its first parent's
 Chromosone::Chromosone(const Chromosone& c, bool setupOnly) :
-    GaMultiValueChromosome<list<Student*> >(c, setupOnly)
+    GaMultiValueChromosome<list<Student*> >(c, setupOnly),
+    _mutationProbability(c._mutationProbability),
+    _mutationSize(c._mutationSize),
+    _probSwap(c._probSwap)
 {
     if (!setupOnly) { // Then copy the data
         _values = c._values;
         _lookup = c._lookup;
         _backupLookup = c._backupLookup;
+        _score = c._score;
     }
     else { // Reserve space
         _values.resize( SLOTS_IN_DAY * Configuration::getInstance().numTutors() );
@@ -37,99 +57,199 @@ Chromosone::Chromosone(const Chromosone& c, bool setupOnly) :
 
 GaChromosomePtr Chromosone::MakeCopy(bool setupOnly) const { return new Chromosone( *this, setupOnly ); }
 
-//Create a new, random chromosome using *this as a prototype for the setup
-// Also, if we're using a previously found solution, add this solution in as the first chromosome
+//Create a new chromosome using *this as a prototype for the setup, filled in according to nextInitMode()
 GaChromosomePtr Chromosone::MakeNewFromPrototype() const {
+    TTInitMode mode = nextInitMode();
+    return makeNew( mode, GaGlobalRandomIntegerGenerator, GaGlobalRandomFloatGenerator, TimetablerInst::getInstance()->carriedAdded() - 1 );
+}
+
+TTInitMode Chromosone::nextInitMode() const {
+    
+    // If we haven't already, and we've loaded a prevsious solution, then seed this soluton into the chromosome set.
+    // This solution will likely dominate as it will be nearly optimal and will spread by crossover. 
+    if ( !TimetablerInst::getInstance()->bestAdded() && Configuration::getInstance().prevSolutionLoaded() )
+        return TT_INIT_PREVIOUS;
+    
+    // Then whatever's left of the last run, if the configuration's been edited since
+    if ( TimetablerInst::getInstance()->carriedWanted() )
+        return TT_INIT_CARRIED;
+    
+    // The next few may be seeded from a matching
+    if ( TimetablerInst::getInstance()->matchingSeedWanted() )
+        return TT_INIT_MATCHING;
+    
+    // Else fill it in according to the parameters
+    return dynamic_cast<const TTChromosomeParams*>(&GetParameters())->getInitMode();
+}
+
+GaChromosomePtr Chromosone::makeNew(TTInitMode mode, GaRandomInteger* randomInteger, GaRandomFloat* randomFloat, int carried) const {
     
     // Make new chromosone copying setup
     Chromosone* newChromosone = new Chromosone(*this, true);
     
+    // Spread out the mutation parameters, to give self-adaptation something to select from
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&GetParameters());
+    newChromosone->perturbStrategy( params->getSelfAdaptationRate(), randomFloat );
     
-    // If we haven't already, and we've loaded a prevsious solution, then seed this soluton into the chromosome set.
-    // This solution will likely dominate as it will be nearly optimal and will spread by crossover. 
-    bool addbest = !TimetablerInst::getInstance()->bestAdded() && Configuration::getInstance().prevSolutionLoaded();
-    if ( addbest ) {
-        
-        // Set changedSlots back to 0 if altered
-        Configuration::getInstance().resetChangedSlots();
-        
-        vector<list<int> > prevSolution = Configuration::getInstance().getPrevSolution();
-        
-        // hashmap that links baseID -> list of the students with this baseID
-        hash_map<int, list<Student*> > studentsById;
-        
-        //for each student
-        list<Student*> students = Configuration::getInstance().getStudents();
-        
-        for (list<Student*>::iterator it = students.begin(); it!= students.end(); it++) {
+    switch (mode) {
+        case TT_INIT_PREVIOUS:
+            newChromosone->constructPrevious(randomInteger);
+            break;
             
-            // add them to the appropriate list
-            studentsById[ (*it)->getBaseID() ].push_back(*it);
+        case TT_INIT_MATCHING:
+            newChromosone->constructMatching(randomFloat);
+            break;
             
-        }
+        case TT_INIT_CARRIED:
+            newChromosone->constructCarried( TimetablerInst::getCarried(carried), randomInteger );
+            break;
+            
+        case TT_INIT_GREEDY:
+            newChromosone->constructGreedy(randomInteger, randomFloat);
+            break;
+            
+        case TT_INIT_DSATUR:
+            newChromosone->constructDSatur(randomInteger, randomFloat);
+            break;
+            
+        default:
+            newChromosone->constructRandom(randomInteger);
+    }
+    
+    //debug
+//    for (hash_map<Student*,int>::const_iterator it = newChromosone->_lookup.begin(); it != newChromosone->_lookup.end(); it++) {
+//        pair<Student*, int> thepair = *it;
+//        string name = thepair.first->getName();
+//        int num = thepair.second;
+//        cout << name << "\t\tis at\t\t" << num << endl;
+//    }
+//    printf("After creation, table has %i students\n", (int)newChromosone->_lookup.size());
+    //end debug
+    
+    return newChromosone;
+}
 
+// Fill in the previous solution, with anyone who wasn't in it in random slots
+void Chromosone::constructPrevious(GaRandomInteger* random) {
+    
+    // Set changedSlots back to 0 if altered
+    Configuration::getInstance().resetChangedSlots();
+    
+    vector<list<int> > prevSolution = Configuration::getInstance().getPrevSolution();
+    
+    // hashmap that links baseID -> list of the students with this baseID
+    hash_map<int, list<Student*> > studentsById;
+    
+    //for each student
+    list<Student*> students = Configuration::getInstance().getStudents();
+    
+    for (list<Student*>::iterator it = students.begin(); it!= students.end(); it++) {
         
-        // hashmap now contains all the students by baseID
+        // add them to the appropriate list
+        studentsById[ (*it)->getBaseID() ].push_back(*it);
         
-        // for each slot in new chromosome
-        for (int i=0; i < newChromosone->_values.size(); i++) {
-            // for each student in the previous solution in this slot
-            if (i < prevSolution.size() ) {
-                for (list<int>::iterator it=prevSolution[i].begin(); it!=prevSolution[i].end(); it++) {
+    }
+
+    
+    // hashmap now contains all the students by baseID
+    
+    // for each slot in new chromosome
+    for (int i=0; i < (int)_values.size(); i++) {
+        // for each student in the previous solution in this slot
+        if (i < (int)prevSolution.size() ) {
+            for (list<int>::iterator it=prevSolution[i].begin(); it!=prevSolution[i].end(); it++) {
 
-                    // add the first student with this baseID to the table:
-                    
-                    // get the student
-                    Student* student;
+                // add the first student with this baseID to the table:
+                
+                // get the student
+                Student* student;
 
-                    
-                    if ( (studentsById.find(*it) != studentsById.end()) && !(student = studentsById[*it].front()) ) {
-    //                    Assignation failed either because the list is empty: we've run out of students
-    //                    with this baseID, possibly because the user removed them from the config, or because this ID is not in the current config
+                
+                if ( (studentsById.find(*it) != studentsById.end()) && !(student = studentsById[*it].front()) ) {
+//                    Assignation failed either because the list is empty: we've run out of students
+//                    with this baseID, possibly because the user removed them from the config, or because this ID is not in the current config
 #ifdef DEBUG
-                        cerr << "Previous student not found:  baseID = " << *it << "\n";
+                    cerr << "Previous student not found:  baseID = " << *it << "\n";
 #endif
-                        continue;
-                    }
+                    continue;
+                }
+            
                 
-                    
-                    // store in the chromosome
-                    newChromosone->_values[i].push_back( student );
-                    newChromosone->_lookup[ student ] = i;
-                    
-                    // remove this first student from the list, so that it is not added again
-                    studentsById[*it].erase(studentsById[*it].begin());
+                // store in the chromosome
+                _values[i].push_back( student );
+                _lookup[ student ] = i;
+                
+                // remove this first student from the list, so that it is not added again
+                studentsById[*it].erase(studentsById[*it].begin());
 
-                }
             }
+        }
+
+    }
+    
+    // Redistribute remaining students randomly
+    for (hash_map<int, list<Student*> >::iterator it=studentsById.begin(); it!=studentsById.end(); it++) {
+        for (list<Student*>::iterator it2=(*it).second.begin(); it2!=(*it).second.end(); it2++) {
+            
+            int pos;
+            pos = random->Generate( SLOTS_IN_DAY * Configuration::getInstance().numTutors() - 1 );
+            
+            // Add the current student to the list at the location 'pos' in the _values vector
+            _values.at(pos).push_back( (*it2) );
+            
+            // Add the (student*,position) pair to the hashmap
+            _lookup.insert(pair<Student*, int>( (*it2) ,pos));
+            
+            Configuration::getInstance().incrementChangedSlots();
 
         }
-        
-        // Redistribute remaining students randomly
-        for (hash_map<int, list<Student*> >::iterator it=studentsById.begin(); it!=studentsById.end(); it++) {
-            for (list<Student*>::iterator it2=(*it).second.begin(); it2!=(*it).second.end(); it2++) {
-                
-                int pos;
-                pos = GaGlobalRandomIntegerGenerator->Generate( SLOTS_IN_DAY * Configuration::getInstance().numTutors() - 1 );
-                
-                // Add the current student to the list at the location 'pos' in the _values vector
-                newChromosone->_values.at(pos).push_back( (*it2) );
-                
-                // Add the (student*,position) pair to the hashmap
-                newChromosone->_lookup.insert(pair<Student*, int>( (*it2) ,pos));
-                
-                Configuration::getInstance().incrementChangedSlots();
+    }
+}
 
-            }
+void Chromosone::constructCarried(const vector<list<int> >& layout, GaRandomInteger* randomInteger) {
+    
+    Configuration& config = Configuration::getInstance();
+    
+    // The students still to place, by baseID
+    hash_map<int, list<Student*> > studentsById;
+    const vector<Student*>& students = config.getStudentVector();
+    for (vector<Student*>::const_iterator it = students.begin(); it != students.end(); it++)
+        studentsById[ (*it)->getBaseID() ].push_back(*it);
+    
+    // Put each of the kept interviews back, as long as their slot and student still exist
+    int numSlots = (int)min( layout.size(), _values.size() );
+    
+    for (int slot = 0; slot < numSlots; slot++) {
+        for (list<int>::const_iterator it = layout[slot].begin(); it != layout[slot].end(); it++) {
+            hash_map<int, list<Student*> >::iterator found = studentsById.find(*it);
+            if ( found == studentsById.end() || (*found).second.empty() ) continue;
+            
+            Student* student = (*found).second.front();
+            (*found).second.pop_front();
+            
+            _values[slot].push_back(student);
+            _lookup[student] = slot;
+        }
+    }
+    
+    // Anyone left over somewhere they can do, if anywhere
+    for (hash_map<int, list<Student*> >::iterator it = studentsById.begin(); it != studentsById.end(); it++) {
+        for (list<Student*>::iterator student = (*it).second.begin(); student != (*it).second.end(); student++) {
+            const vector<int>& feasible = config.getConstraints(*student).feasibleSlots;
+            
+            int slot = feasible.empty() ? randomInteger->Generate( (int)_values.size() - 1 )
+                                        : feasible[ randomInteger->Generate( (int)feasible.size() - 1 ) ];
+            
+            _values[slot].push_back(*student);
+            _lookup[*student] = slot;
         }
-        
-        
-        
-        // return the optimal chromosome
-        return newChromosone;
     }
+    
+    // Then unstack them
+    TTRepair().repair(this);
+}
 
-//   Else, if this isn't the first chromosome or we're not using a previous solution: randomise like normal
+void Chromosone::constructRandom(GaRandomInteger* randomInteger) {
     
     //Get all the students:
     const list<Student*>& students = Configuration::getInstance().getStudents();
@@ -140,165 +260,926 @@ GaChromosomePtr Chromosone::MakeNewFromPrototype() const {
         Student* currStudent = *it;
         //choose random position:
         int pos;
-        pos = GaGlobalRandomIntegerGenerator->Generate( SLOTS_IN_DAY * Configuration::getInstance().numTutors() - 1 );
+        pos = randomInteger->Generate( SLOTS_IN_DAY * Configuration::getInstance().numTutors() - 1 );
         
         // Add the current student to the list at the location 'pos' in the _values vector
-        newChromosone->_values.at(pos).push_back(currStudent);
+        _values.at(pos).push_back(currStudent);
         
         // Add the (student*,position) pair to the hashmap
-        newChromosone->_lookup.insert(pair<Student*, int>(currStudent,pos));
+        _lookup.insert(pair<Student*, int>(currStudent,pos));
+        
+    }
+}
+
+// Largest random amount added to a slot's score to break ties. Much smaller than any real difference in score
+#define GREEDY_TIE_BREAK 0.001
+
+void Chromosone::constructGreedy(GaRandomInteger* randomInteger, GaRandomFloat* randomFloat) {
+    
+    const Configuration& config = Configuration::getInstance();
+    int numSlots = (int)_values.size();
+    
+    // Count the slots each student could take without breaking an essential requirement (ignoring everyone else)
+    vector<pair<int, Student*> > order;
+    const vector<Student*>& students = config.getStudentVector();
+    
+    for (vector<Student*>::const_iterator it = students.begin(); it != students.end(); it++) {
+        const StudentConstraints& constraints = config.getConstraints(*it);
+        
+        int feasible = 0;
+        for (int slot = 0; slot < numSlots; slot++) {
+            div_t division = div(slot, SLOTS_IN_DAY);
+            if ( constraints.proficiency[division.quot] >= 0 && constraints.canDoTime[division.rem] && config.tutorCanDoSlot(slot) )
+                feasible++;
+        }
+        
+        order.push_back( pair<int, Student*>( feasible, *it ) );
+    }
+    
+    // Most constrained first. Shuffle before the stable sort so that equally constrained students come in a random order
+    for (int i = (int)order.size() - 1; i > 0; i--)
+        swap( order[i], order[ randomInteger->Generate(i) ] );
+    
+    stable_sort( order.begin(), order.end(),
+                 [](const pair<int, Student*>& a, const pair<int, Student*>& b) { return a.first < b.first; } );
+    
+    // Put each student in their best slot given who's already been placed
+    for (vector<pair<int, Student*> >::iterator it = order.begin(); it != order.end(); it++) {
+        
+        int bestSlot = 0;
+        float bestScore = -1;
+        
+        for (int slot = 0; slot < numSlots; slot++) {
+            float score = greedyScore(it->second, slot) + randomFloat->Generate() * GREEDY_TIE_BREAK;
+            if (score > bestScore) {
+                bestScore = score;
+                bestSlot = slot;
+            }
+        }
+        
+        _values[bestSlot].push_back(it->second);
+        _lookup.insert( pair<Student*, int>( it->second, bestSlot ) );
+    }
+}
+
+// Number of times to re-solve the matching after moving students away from clashes with their own other interviews
+#define MATCHING_CONFLICT_ROUNDS 5
+
+// Ignoring the grouping, pairing and previous tutor terms, the best timetables assign each interview its own slot
+//   with a tutor who teaches the subject at a time both can do: a bipartite matching between interviews and slots.
+//   The slots are offered to the matcher in a random order weighted towards better tutors, so repeated calls give
+//   different timetables
+void Chromosone::constructMatching(GaRandomFloat* randomFloat) {
+    
+    const Configuration& config = Configuration::getInstance();
+    const vector<Student*>& students = config.getStudentVector();
+    int numStudents = (int)students.size();
+    int numSlots = (int)_values.size();
+    
+    TTHopcroftKarp matcher(numStudents, numSlots);
+    hash_map<Student*, int> index;
+    
+    for (int i = 0; i < numStudents; i++) {
+        const StudentConstraints& constraints = config.getConstraints(students[i]);
+        index[ students[i] ] = i;
+        
+        vector<pair<float, int> > slots;
+        for (int slot = 0; slot < numSlots; slot++) {
+            div_t division = div(slot, SLOTS_IN_DAY);
+            float proficiency = constraints.proficiency[division.quot];
+            
+            if ( proficiency >= 0 && constraints.canDoTime[division.rem] && config.tutorCanDoSlot(slot) )
+                slots.push_back( pair<float, int>( proficiency + (constraints.prevTutor[division.quot] ? 0 : 0.1) + randomFloat->Generate(), slot ) );
+        }
+        
+        sort( slots.rbegin(), slots.rend() );
+        for (vector<pair<float, int> >::iterator it = slots.begin(); it != slots.end(); it++)
+            matcher.addEdge(i, it->second);
+    }
+    
+    matcher.solve();
+    
+    // Time-column conflicts: if two of a student's interviews are at the same time, take the later one's
+    //   edges out of that time column and re-solve
+    for (int round = 0; round < MATCHING_CONFLICT_ROUNDS; round++) {
+        
+        bool conflicts = false;
+        
+        for (int i = 0; i < numStudents; i++) {
+            int slot = matcher.getMatch(i);
+            if (slot < 0) continue;
+            
+            const vector<Student*>& siblings = config.getConstraints(students[i]).siblings;
+            for (vector<Student*>::const_iterator it = siblings.begin(); it != siblings.end(); it++) {
+                int j = index[*it];
+                if ( j <= i || matcher.getMatch(j) < 0 || matcher.getMatch(j) % SLOTS_IN_DAY != slot % SLOTS_IN_DAY ) continue;
+                
+                for (int otherSlot = slot % SLOTS_IN_DAY; otherSlot < numSlots; otherSlot += SLOTS_IN_DAY)
+                    matcher.removeEdge(j, otherSlot);
+                conflicts = true;
+            }
+        }
+        
+        if (!conflicts) break;
+        matcher.solve();
+    }
+    
+    // Place the matched interviews, then anyone left over wherever suits them best
+    vector<Student*> unmatched;
+    for (int i = 0; i < numStudents; i++) {
+        int slot = matcher.getMatch(i);
+        if (slot < 0) {
+            unmatched.push_back(students[i]);
+            continue;
+        }
+        _values[slot].push_back(students[i]);
+        _lookup.insert( pair<Student*, int>( students[i], slot ) );
+    }
+    
+    for (vector<Student*>::iterator it = unmatched.begin(); it != unmatched.end(); it++) {
+        int bestSlot = 0;
+        float bestScore = -1;
+        
+        for (int slot = 0; slot < numSlots; slot++) {
+            float score = greedyScore(*it, slot) + randomFloat->Generate() * GREEDY_TIE_BREAK;
+            if (score > bestScore) {
+                bestScore = score;
+                bestSlot = slot;
+            }
+        }
+        
+        _values[bestSlot].push_back(*it);
+        _lookup.insert( pair<Student*, int>( *it, bestSlot ) );
+    }
+}
+
+// A student's interviews must all be at different times, so giving each interview a time is a colouring of the
+//   graph joining interviews with the same baseID, with each interview's colours restricted to the times at
+//   which it has a feasible slot (a tutor who teaches the subject, and both free) that hasn't been taken.
+//   DSATUR colours the interview with the fewest times left first, breaking ties by the most uncoloured
+//   neighbours and then randomly. It then picks the time that best groups the student's interviews, and the
+//   best free tutor at that time. Interviews left with no feasible time go wherever suits them best
+void Chromosone::constructDSatur(GaRandomInteger* randomInteger, GaRandomFloat* randomFloat) {
+    
+    const Configuration& config = Configuration::getInstance();
+    const vector<Student*>& students = config.getStudentVector();
+    int numStudents = (int)students.size();
+    int numSlots = (int)_values.size();
+    
+    hash_map<Student*, int> index;
+    for (int i = 0; i < numStudents; i++) index[ students[i] ] = i;
+    
+    // Domains: each interview's feasible slots at each time, and the interviews that could use each slot
+    vector<vector<vector<int> > > domain( numStudents, vector<vector<int> >(SLOTS_IN_DAY) );
+    vector<vector<int> > users(numSlots);
+    
+    for (int i = 0; i < numStudents; i++) {
+        const StudentConstraints& constraints = config.getConstraints(students[i]);
+        for (int slot = 0; slot < numSlots; slot++) {
+            div_t division = div(slot, SLOTS_IN_DAY);
+            if ( constraints.proficiency[division.quot] >= 0 && constraints.canDoTime[division.rem] && config.tutorCanDoSlot(slot) ) {
+                domain[i][division.rem].push_back(slot);
+                users[slot].push_back(i);
+            }
+        }
+    }
+    
+    // freeSlots[i][t]: untaken feasible slots interview i has at time t. blocked[i][t]: one of i's siblings is at time t.
+    //   available[i]: times with free slots that aren't blocked, i.e. i's remaining colours
+    vector<vector<int> > freeSlots( numStudents, vector<int>(SLOTS_IN_DAY) );
+    vector<vector<bool> > blocked( numStudents, vector<bool>(SLOTS_IN_DAY, false) );
+    vector<int> available(numStudents, 0), degree(numStudents);
+    vector<bool> placed(numStudents, false);
+    
+    for (int i = 0; i < numStudents; i++) {
+        for (int t = 0; t < SLOTS_IN_DAY; t++) {
+            freeSlots[i][t] = (int)domain[i][t].size();
+            if (freeSlots[i][t]) available[i]++;
+        }
+        degree[i] = (int)config.getConstraints(students[i]).siblings.size() - 1;
+    }
+    
+    // Visit the interviews in a random order so that ties are broken randomly
+    vector<int> order(numStudents);
+    for (int i = 0; i < numStudents; i++) order[i] = i;
+    for (int i = numStudents - 1; i > 0; i--)
+        swap( order[i], order[ randomInteger->Generate(i) ] );
+    
+    for (int step = 0; step < numStudents; step++) {
+        
+        // Pick the most saturated interview
+        int next = -1;
+        for (vector<int>::iterator it = order.begin(); it != order.end(); it++) {
+            if ( placed[*it] ) continue;
+            if ( next < 0 || available[*it] < available[next] || (available[*it] == available[next] && degree[*it] > degree[next]) )
+                next = *it;
+        }
+        
+        Student* student = students[next];
+        const StudentConstraints& constraints = config.getConstraints(student);
+        int slot = -1;
+        
+        if ( available[next] ) {
+            
+            // Time first: the one that puts it in the same session as most of the student's other interviews so far
+            int bestTime = -1;
+            float bestScore = -1;
+            for (int t = 0; t < SLOTS_IN_DAY; t++) {
+                if ( blocked[next][t] || !freeSlots[next][t] ) continue;
+                
+                float score = randomFloat->Generate() * 0.5F;
+                for (vector<Student*>::const_iterator it = constraints.siblings.begin(); it != constraints.siblings.end(); it++)
+                    if ( placed[ index[*it] ] && sessionOf( getSlot(*it) % SLOTS_IN_DAY ) == sessionOf(t) ) score++;
+                
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTime = t;
+                }
+            }
+            
+            // Then tutor: the best free one
+            bestScore = -1;
+            for (vector<int>::iterator it = domain[next][bestTime].begin(); it != domain[next][bestTime].end(); it++) {
+                if ( !_values[*it].empty() ) continue;
+                
+                float score = greedyScore(student, *it) + randomFloat->Generate() * GREEDY_TIE_BREAK;
+                if (score > bestScore) {
+                    bestScore = score;
+                    slot = *it;
+                }
+            }
+        }
+        else {
+            float bestScore = -1;
+            for (int s = 0; s < numSlots; s++) {
+                float score = greedyScore(student, s) + randomFloat->Generate() * GREEDY_TIE_BREAK;
+                if (score > bestScore) {
+                    bestScore = score;
+                    slot = s;
+                }
+            }
+        }
+        
+        // Taking a free slot takes it out of everyone else's domain
+        if ( _values[slot].empty() ) {
+            int t = slot % SLOTS_IN_DAY;
+            for (vector<int>::iterator it = users[slot].begin(); it != users[slot].end(); it++) {
+                if ( placed[*it] ) continue;
+                if ( --freeSlots[*it][t] == 0 && !blocked[*it][t] ) available[*it]--;
+            }
+        }
+        
+        _values[slot].push_back(student);
+        _lookup.insert( pair<Student*, int>( student, slot ) );
+        placed[next] = true;
+        
+        // ... and the time is now blocked for the student's other interviews
+        int t = slot % SLOTS_IN_DAY;
+        for (vector<Student*>::const_iterator it = constraints.siblings.begin(); it != constraints.siblings.end(); it++) {
+            int j = index[*it];
+            if ( placed[j] ) continue;
+            
+            degree[j]--;
+            if ( !blocked[j][t] ) {
+                blocked[j][t] = true;
+                if ( freeSlots[j][t] ) available[j]--;
+            }
+        }
+    }
+}
+
+float Chromosone::greedyScore(Student* student, int slot) const {
+    
+    const StudentConstraints& constraints = Configuration::getInstance().getConstraints(student);
+    const TTWeights& weights = Configuration::getInstance().getWeights();
+    
+    float score = 0;
+    
+    if ( _values[slot].empty() ) score += weights.getPoints(TT_CRIT_OVERLAP);
+    
+    div_t division = div(slot, SLOTS_IN_DAY);
+    int tutor = division.quot;
+    int time = division.rem;
+    
+    if ( constraints.proficiency[tutor] >= 0 ) score += constraints.proficiency[tutor] * weights.getPoints(TT_CRIT_PROFICIENCY);
+    if ( Configuration::getInstance().tutorCanDoSlot(slot) ) score += weights.getPoints(TT_CRIT_TUTOR_AVAILABILITY);
+    if ( constraints.canDoTime[time] ) score += weights.getPoints(TT_CRIT_STUDENT_AVAILABILITY);
+    if ( !constraints.prevTutor[tutor] ) score += weights.getPoints(TT_CRIT_PREV_TUTOR);
+    
+    // Compare with this student's other interviews that have already been placed
+    bool busy = false, paired = false;
+    int samegroup = 0;
+    
+    int session = sessionOf(time);
+    
+    for (vector<Student*>::const_iterator it = constraints.siblings.begin(); it != constraints.siblings.end(); it++) {
+        hash_map<Student*, int>::const_iterator found = _lookup.find(*it);
+        if ( *it == student || found == _lookup.end() ) continue;
+        
+        int otherTime = found->second % SLOTS_IN_DAY;
+        if (otherTime == time) busy = true;
+        if (sessionOf(otherTime) == session) samegroup++;
+        if (found->second / SLOTS_IN_DAY == tutor) paired = true;
+    }
+    
+    if (!busy) score += weights.getPoints(TT_CRIT_ENGAGEMENTS);
+    if (!paired) score += weights.getPoints(TT_CRIT_PAIRING);
+    score += samegroup * weights.getPoints(TT_CRIT_GROUPING);
+    
+    return score;
+}
+
+// Bounds on the self-adapted mutation parameters
+#define MIN_MUTATION_PROBABILITY 0.005F
+#define MAX_MUTATION_PROBABILITY 0.5F
+#define MIN_MUTATION_SIZE 1.0F
+#define MAX_MUTATION_SIZE 10.0F
+#define MIN_PROB_SWAP 0.01F
+#define MAX_PROB_SWAP 0.9F
+
+// A sample from the standard normal distribution, by the Box-Muller transform
+static double gaussian(GaRandomFloat* random) {
+    double u = 1.0 - random->Generate();    // in (0, 1], so the log is finite
+    double v = random->Generate();
+    return sqrt( -2.0 * log(u) ) * cos( 2.0 * M_PI * v );
+}
+
+void Chromosone::perturbStrategy(double rate, GaRandomFloat* random) {
+    
+    if (rate <= 0) return;
+    
+    _mutationProbability = min( MAX_MUTATION_PROBABILITY, max( MIN_MUTATION_PROBABILITY, _mutationProbability * (float)exp( rate * gaussian(random) ) ) );
+    _mutationSize = min( MAX_MUTATION_SIZE, max( MIN_MUTATION_SIZE, _mutationSize * (float)exp( rate * gaussian(random) ) ) );
+    
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&GetParameters());
+    if ( !params->getScheduler() )
+        _probSwap = min( MAX_PROB_SWAP, max( MIN_PROB_SWAP, _probSwap * (float)exp( rate * gaussian(random) ) ) );
+}
+
+void Chromosone::inheritStrategy(const Chromosone& parent1, const Chromosone& parent2) {
+    _mutationProbability = sqrt( parent1._mutationProbability * parent2._mutationProbability );
+    _mutationSize = sqrt( parent1._mutationSize * parent2._mutationSize );
+    _probSwap = ( parent1._probSwap + parent2._probSwap ) / 2;
+}
+
+// As GaDefaultChromosome::Mutation, but using this chromosome's own mutation probability after first
+//   perturbing it (self-adaptation: parameters that produce fitter children survive with them)
+void Chromosone::Mutation() {
+    
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&GetParameters());
+    perturbStrategy( params->getSelfAdaptationRate(), GaGlobalRandomFloatGenerator );
+    
+    if ( !GaGlobalRandomBoolGenerator->Generate( _mutationProbability ) ) return;
+    
+    // backup chromosome's code if needed
+    if ( params->GetImprovingMutationsFlag() )
+        PreapareForMutation();
+    
+    // Our own mutation knows exactly how much it changed the score, which saves rescoring the whole timetable
+    //   and lets us compare the scores themselves
+    float newFitness;
+    bool worse;
+    if ( dynamic_cast<const TTMutation*>( &( (GaChromosomeOperationsBlock*)_configBlock )->GetMutationOperation() ) ) {
+        _score += TTMutation::mutate(this);
+        newFitness = TTFitness::fitness(this, _score);
+        worse = params->GetImprovingMutationsFlag() && TTScoreComparator::compare( _score, _backupScore ) < 0;
+    }
+    else {
+        PerformMutation();
+        newFitness = CalculateFitness();
+        worse = params->GetImprovingMutationsFlag() && CompareFitnesses( newFitness ) > 0;
+    }
+    
+    // improvement?
+    if ( worse ) {
+        // mutation did not make any improvments - reject it
+        RejectMutation();
+        return;
+    }
+    
+    _fitness = newFitness;
+    
+    if ( params->GetImprovingMutationsFlag() ) AcceptMutation();
+}
+
+void Chromosone::PreapareForMutation() {
+    _backupScore = _score;
+    _backupLookup = _lookup; // Backup hashmap then call method to backup rest
+   	GaMultiValueChromosome<list<Student*> >::PreapareForMutation();
+}
+
+void Chromosone::AcceptMutation() {
+    _backupLookup.clear(); // Clear backup and accept
+   	GaMultiValueChromosome<list<Student*> >::AcceptMutation();
+}
+
+void Chromosone::RejectMutation() {
+    _score = _backupScore;
+    _lookup = _backupLookup; // Restore backup hashmap then call method to reject rest
+    _backupLookup.clear();
+   	GaMultiValueChromosome<list<Student*> >::RejectMutation();
+}
+
+
+
+void Chromosone::relocate(Student* s, int from, int to) {
+    
+    //delete from old:
+    list<Student*>& theOldSlot = _values[from];
+    for (list<Student*>::iterator itOld = theOldSlot.begin(); itOld != theOldSlot.end(); itOld++) {
+        if ( *itOld == s )
+        {
+            theOldSlot.erase(itOld);
+            break;
+        }
+    }
+    
+    //add to new:
+    _values[to].push_back(s);
+    
+    //update hashmap:
+    _lookup[s] = to;
+}
+
+void Chromosone::applyMove(const TTMove& move) {
+    relocate(move.student, move.fromSlot, move.toSlot);
+    if (move.other) relocate(move.other, move.toSlot, move.fromSlot);
+}
+
+void Chromosone::undoMove(const TTMove& move) {
+    if (move.other) relocate(move.other, move.fromSlot, move.toSlot);
+    relocate(move.student, move.toSlot, move.fromSlot);
+}
+
+void Chromosone::applyMoves(const vector<TTMove>& moves) {
+    for (vector<TTMove>::const_iterator it = moves.begin(); it != moves.end(); it++)
+        applyMove(*it);
+}
+
+void Chromosone::undoMoves(const vector<TTMove>& moves) {
+    for (vector<TTMove>::const_reverse_iterator it = moves.rbegin(); it != moves.rend(); it++)
+        undoMove(*it);
+}
+
+
+TTOperator TTOperatorSet::choose(double random) const {
+    
+    double total = 0;
+    for (int i = 0; i < TT_NUM_OPERATORS; i++) total += _weights[i];
+    
+    double target = random * total;
+    
+    // Fall through to the last operator with any weight, in case of rounding
+    int chosen = TT_OP_MOVE;
+    for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+        if (_weights[i] <= 0) continue;
+        chosen = i;
+        if (target < _weights[i]) break;
+        target -= _weights[i];
+    }
+    
+    return (TTOperator)chosen;
+}
+
+
+TTMove TTMutation::randomMove(const Chromosone* chromo, bool swap, GaRandomInteger* random) {
+    
+    const Configuration& config = Configuration::getInstance();
+    const vector<Student*>& students = config.getStudentVector();
+    int numStudents = (int)students.size();
+    
+    // pick a random student
+    Student* theStudent = students[ random->Generate(numStudents-1) ];
+    int oldSlot = chromo->getSlot(theStudent);
+    
+    if (!swap) {
+        //pick a random new slot in their component:
+        return TTMove(theStudent, oldSlot, componentSlot(chromo, theStudent, random));
+    }
+    
+    // pick another random student from their component to swap with
+    int component = config.getConstraints(theStudent).component;
+    const vector<Student*>& others = component < 0 ? students : config.getComponents()[component].students;
+    Student* otherStudent = others[ random->Generate((int)others.size()-1) ];
+    
+    return TTMove(theStudent, oldSlot, chromo->getSlot(otherStudent), otherStudent);
+}
+
+void TTMutation::randomMoves(const Chromosone* chromo, TTOperator op, int depth, vector<TTMove>& moves, GaRandomInteger* random) {
+    
+    moves.clear();
+    
+    switch (op) {
+        case TT_OP_EJECTION_CHAIN:
+            ejectionChain(chromo, depth, moves, random);
+            break;
+            
+        case TT_OP_KEMPE_CHAIN:
+            kempeChain(chromo, depth, moves, random);
+            break;
+            
+        default:
+            moves.push_back( randomMove(chromo, op == TT_OP_SWAP, random) );
+    }
+}
+
+// Number of random slots to try before giving up on finding a suitable one
+#define SUITABLE_SLOT_TRIES 8
+
+int TTMutation::componentSlot(const Chromosone* chromo, Student* student, GaRandomInteger* random) {
+    
+    const Configuration& config = Configuration::getInstance();
+    int component = config.getConstraints(student).component;
+    
+    if (component < 0) return random->Generate( (int)chromo->_values.size() - 1 );
+    
+    const vector<int>& tutors = config.getComponents()[component].tutors;
+    return tutors[ random->Generate( (int)tutors.size() - 1 ) ] * SLOTS_IN_DAY + random->Generate(SLOTS_IN_DAY-1);
+}
+
+int TTMutation::suitableSlot(const Chromosone* chromo, Student* student, GaRandomInteger* random) {
+    
+    const Configuration& config = Configuration::getInstance();
+    const StudentConstraints& constraints = config.getConstraints(student);
+    
+    int slot = 0;
+    for (int i = 0; i < SUITABLE_SLOT_TRIES; i++) {
+        slot = componentSlot(chromo, student, random);
+        
+        div_t division = div(slot, SLOTS_IN_DAY);
+        if ( constraints.proficiency[division.quot] >= 0 && constraints.canDoTime[division.rem] && config.tutorCanDoSlot(slot) )
+            break;
+    }
+    
+    return slot;
+}
+
+// Move a random student A into a suitable slot, eject someone B who was there into a suitable slot of their own, and so on.
+//   The chain stops when it reaches an empty slot, or at depth students, when the last one goes into A's old slot
+void TTMutation::ejectionChain(const Chromosone* chromo, int depth, vector<TTMove>& moves, GaRandomInteger* random) {
+    
+    const vector<Student*>& students = Configuration::getInstance().getStudentVector();
+    
+    Student* student = students[ random->Generate((int)students.size()-1) ];
+    int start = chromo->getSlot(student);
+    
+    vector<int> visited(1, start);
+    int from = start;
+    
+    for (int i = 1; ; i++) {
+        
+        int to = (i < depth || i == 1) ? suitableSlot(chromo, student, random) : start;
+        moves.push_back( TTMove(student, from, to) );
+        
+        // Stop if we've closed the chain, come back on ourselves or found an empty slot
+        const list<Student*>& occupants = chromo->_values[to];
+        if ( find(visited.begin(), visited.end(), to) != visited.end() || occupants.empty() )
+            break;
+        
+        // Eject one of the occupants
+        list<Student*>::const_iterator it = occupants.begin();
+        advance( it, random->Generate((int)occupants.size()-1) );
+        
+        student = *it;
+        from = to;
+        visited.push_back(to);
+    }
+}
+
+// Swap a random student's interview into another time, keeping their tutor, then move whoever that clashes with
+//   (the tutor's interview at the new time, or the same student's other interviews) the other way, and so on
+//   between the two times. Involves at most depth students
+void TTMutation::kempeChain(const Chromosone* chromo, int depth, vector<TTMove>& moves, GaRandomInteger* random) {
+    
+    const vector<Student*>& students = Configuration::getInstance().getStudentVector();
+    
+    vector<Student*> chain( 1, students[ random->Generate((int)students.size()-1) ] );
+    
+    int time1 = chromo->getSlot(chain[0]) % SLOTS_IN_DAY;
+    int time2 = random->Generate(SLOTS_IN_DAY-2);
+    if (time2 >= time1) time2++;
+    
+    for (int i = 0; i < (int)chain.size(); i++) {
+        
+        int slot = chromo->getSlot(chain[i]);
+        int time = slot % SLOTS_IN_DAY;
+        int otherTime = (time == time1) ? time2 : time1;
+        int dest = slot - time + otherTime;
+        
+        moves.push_back( TTMove(chain[i], slot, dest) );
+        
+        // Add everyone this would clash with to the chain
+        const list<Student*>& occupants = chromo->_values[dest];
+        for (list<Student*>::const_iterator it = occupants.begin(); it != occupants.end() && (int)chain.size() < depth; it++)
+            addUnique(chain, *it);
+        
+        const vector<Student*>& siblings = Configuration::getInstance().getConstraints(chain[i]).siblings;
+        for (vector<Student*>::const_iterator it = siblings.begin(); it != siblings.end() && (int)chain.size() < depth; it++)
+            if ( chromo->getSlot(*it) % SLOTS_IN_DAY == otherTime ) addUnique(chain, *it);
+    }
+}
+
+// Apply one of the operators, chosen according to the weights in the parameters or by their scheduler if
+//   they have one. Plain moves move some (mutation size) students to different (random) slots
+void TTMutation::operator ()(GaChromosome* parent) const
+{
+    mutate( dynamic_cast<Chromosone*>(parent) );
+}
+
+TTScore TTMutation::mutate(Chromosone* chromo)
+{
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&chromo->GetParameters());
+    TTOperatorScheduler* scheduler = params->getScheduler();
+    
+    double random = GaGlobalRandomDoubleGenerator->Generate();
+    TTOperator op = scheduler ? scheduler->choose(random) : params->getOperators().choose(random);
+    
+    // Without a scheduler, the chromosome's own probSwap decides between moves and swaps. With one, the
+    //   scheduler has the final say, so that it's credited with the operator it actually picked
+    if ( !scheduler && (op == TT_OP_MOVE || op == TT_OP_SWAP) )
+        op = GaGlobalRandomBoolGenerator->Generate( chromo->getProbSwap() ) ? TT_OP_SWAP : TT_OP_MOVE;
+    
+    chrono::steady_clock::time_point start;
+    if (scheduler) start = chrono::steady_clock::now();
+    
+    TTScore gain;
+    
+    if (op == TT_OP_MOVE) {
+        //for each mutation:
+        for (int i = chromo->getMutationSize() ; i>0; i--)
+            gain += TTFitness::moveGain( chromo, randomMove(chromo, false) );
+    } else {
+        vector<TTMove> moves;
+        randomMoves(chromo, op, params->getChainDepth(), moves);
+        gain = TTFitness::movesGain(chromo, moves);
+    }
+    
+    // The scheduler needs to know how much the operator gained and how long it took
+    if (scheduler)
+        scheduler->record( op, (float)gain.total() / SCORE_UNITS, chrono::duration_cast<chrono::nanoseconds>( chrono::steady_clock::now() - start ).count() );
+    
+    return gain;
+}
+
+float TTFitness::scoreStudent(const Chromosone* chromo, Student* student, int slot, bool& essential, TTScore* score, TTBreakdown* breakdown) {
+    return _plans[ Configuration::getInstance().getTerms() ]( chromo, student, slot, essential, score, breakdown );
+}
+
+const TTFitness::StudentScorer TTFitness::_plans[TT_NUM_PLANS] = {
+    &scoreStudentWith<0>, &scoreStudentWith<1>, &scoreStudentWith<2>, &scoreStudentWith<3>,
+    &scoreStudentWith<4>, &scoreStudentWith<5>, &scoreStudentWith<6>, &scoreStudentWith<7>
+};
+
+template <int Terms>
+float TTFitness::scoreStudentWith(const Chromosone* chromo, Student* student, int slot, bool& essential, TTScore* score, TTBreakdown* breakdown) {
+    
+    Configuration& config = Configuration::getInstance();
+    const StudentConstraints& constraints = config.getConstraints(student);
+    const TTWeights& weights = config.getWeights();
+    
+    // In SCORE_UNITS
+    long long total = 0;
+    
+    // Add what the criterion earned to the total, and to the exact score and the breakdown if they're wanted
+    auto credit = [&total, score, breakdown](TTCriterion criterion, bool met, long long units) {
+        total += units;
+        if (score) score->units[ getObjective(criterion) ] += units;
+        if (breakdown) breakdown->add(criterion, met, units);
+    };
+    
+    // The essential criteria are always checked, whatever they're worth, so that essential means the same thing
+    
+    //is there overlapping?
+    bool alone = !(chromo->_values[slot].size()>1);
+    credit(TT_CRIT_OVERLAP, alone, alone ? weights.units[TT_CRIT_OVERLAP] : 0);
+    if (!alone) essential = false;
+    
+    //get tutor and time:
+    div_t division = div(slot, SLOTS_IN_DAY);
+    int tutorID = division.quot + 1;
+    int time = division.rem;
+    
+    //Does the tutor teach the subject? (And how well?)
+    // If the tutor teaches the subject, increment the score by the tutor's proficiency in this subject
+    float proficiency = constraints.proficiency[tutorID-1];
+    credit(TT_CRIT_PROFICIENCY, proficiency >= 0, proficiency >= 0 ? (long long)( proficiency * weights.units[TT_CRIT_PROFICIENCY] + 0.5f ) : 0);
+    if (proficiency < 0) essential=false;
+    
+    //can the tutor do the time?
+    bool tutorFree = config.tutorCanDoSlot(slot);
+    credit(TT_CRIT_TUTOR_AVAILABILITY, tutorFree, tutorFree ? weights.units[TT_CRIT_TUTOR_AVAILABILITY] : 0);
+    if (!tutorFree) essential=false;
+    
+    //can the student do the time?
+    bool studentFree = constraints.canDoTime[time];
+    credit(TT_CRIT_STUDENT_AVAILABILITY, studentFree, studentFree ? weights.units[TT_CRIT_STUDENT_AVAILABILITY] : 0);
+    if (!studentFree) essential=false;
+    
+    // Count this student's interviews (students with the same baseID, i.e. the same person,
+    //   including this one) at this time, in this session and, if it's scored, with this tutor.
+    //   The session is counted even when grouping isn't scored, since it's still essential
+    int engagements = 0, samegroup = -1, pairings = 0;
+    // n.b. samegroup starts on -1 since we will find at least one student in this group: the one that we're currently scoring!
+    
+    int session = sessionOf(time);
+    
+    for (vector<Student*>::const_iterator it = constraints.siblings.begin(); it != constraints.siblings.end(); it++) {
+        int otherSlot = (*it == student) ? slot : chromo->getSlot(*it);
+        int otherTime = otherSlot % SLOTS_IN_DAY;
+        
+        if (otherTime == time) engagements++;
+        if ( sessionOf(otherTime) == session ) samegroup++;
+        if ( (Terms & TT_TERM_PAIRING) && otherSlot / SLOTS_IN_DAY == tutorID - 1 ) pairings++;
+    }
+    
+    //is this student already busy at this time?
+    // If we only found them once (ie in the slot we were considering) then score
+    credit(TT_CRIT_ENGAGEMENTS, engagements==1, engagements==1 ? weights.units[TT_CRIT_ENGAGEMENTS] : 0);
+    if (engagements!=1) essential=false;
+    
+    // Are all the other appointments of this student in the same group?
+    //    score for every appointment in the same group
+    bool grouped = samegroup == student->getNoInterviews() - 1;
+    if (Terms & TT_TERM_GROUPING)
+        credit(TT_CRIT_GROUPING, grouped, samegroup * weights.units[TT_CRIT_GROUPING]);
+    if (!grouped) essential = false;
+    
+//         this score is so small because we must consider what happens when a student's / tutor's notTime conflicts with the grouping:
+//             if we have four students grouped in the slots that the student can't do, we require that moving one student out of the group is profitable
+//             the gain is +1 (since we're no longer breaching a notTime
+//             the loss is x for each other slot in the group (3 in this example) + 3x for the slot being moved (since there were three others in the same group)
+//             hence we require that 6x < 1. The default is 6x = 0.5.
+    
+    //  MINOR:
+    //   Does this student/tutor pair appear elsewhere in this timetable?
+    // This is a minor requirement, therefore, if the student is only paired with this tutor
+    //   once then score a small prize, so other req. take precidence
+    if (Terms & TT_TERM_PAIRING)
+        credit(TT_CRIT_PAIRING, pairings==1, pairings==1 ? weights.units[TT_CRIT_PAIRING] : 0);
+    
+    //  MINOR:
+    //   Has the tutor been seen previously in another session?
+    if (Terms & TT_TERM_PREV_TUTOR) {
+        bool newTutor = !constraints.prevTutor[tutorID-1];
+        credit(TT_CRIT_PREV_TUTOR, newTutor, newTutor ? weights.units[TT_CRIT_PREV_TUTOR] : 0);
+    }
+    
+    return (float)total / SCORE_UNITS;
+}
+
+float TTFitness::scorePrevSlot(const Chromosone* chromo, int slot, TTScore* score, TTBreakdown* breakdown) {
+    
+    const vector<list<int> >& prevSolution = Configuration::getInstance().getPrevSolution();
+    const list<Student*>& thisSlot = chromo->_values[slot];
+    
+    bool matches = true;
+    
+    // If we're out of range of prevSolution then treat it as an empty slot: i.e. reward if thisSlot is also empty
+    if ( slot >= (int)prevSolution.size() )
+        matches = thisSlot.empty();
+    
+    else if (thisSlot.empty())
+        matches = prevSolution[slot].empty();
+    
+    // For each student in this slot,
+    //   check if they're in the previous solution
+    else {
+        const list<int>& prevSlot = prevSolution[slot];
         
+        for (list<Student*>::const_iterator it = thisSlot.begin(); it!=thisSlot.end() && matches; it++) {
+            // If this student is not present, the slot doesn't match
+            if ( find(prevSlot.begin(), prevSlot.end(), (*it)->getBaseID()) == prevSlot.end() )
+                matches = false;
+        }
     }
     
-    //debug
-//    for (hash_map<Student*,int>::const_iterator it = newChromosone->_lookup.begin(); it != newChromosone->_lookup.end(); it++) {
-//        pair<Student*, int> thepair = *it;
-//        string name = thepair.first->getName();
-//        int num = thepair.second;
-//        cout << name << "\t\tis at\t\t" << num << endl;
-//    }
-//    printf("After creation, table has %i students\n", (int)newChromosone->_lookup.size());
-    //end debug
+    long long units = Configuration::getInstance().getWeights().units[TT_CRIT_STABILITY];
     
-    return newChromosone;
+    if (breakdown) breakdown->add(TT_CRIT_STABILITY, matches, matches ? units : 0);
+    
+    if (!matches) return 0;
+    
+    if (score) score->units[TT_OBJ_STABILITY] += units;
+    
+    return (float)units / SCORE_UNITS;
 }
 
-void Chromosone::PreapareForMutation() {
-    _backupLookup = _lookup; // Backup hashmap then call method to backup rest
-   	GaMultiValueChromosome<list<Student*> >::PreapareForMutation();
+bool TTFitness::scoresStability() {
+    Configuration& config = Configuration::getInstance();
+    return config.prevSolutionLoaded() && config.getWeights().isEnabled(TT_CRIT_STABILITY);
 }
 
-void Chromosone::AcceptMutation() {
-    _backupLookup.clear(); // Clear backup and accept
-   	GaMultiValueChromosome<list<Student*> >::AcceptMutation();
+TTScore TTFitness::score(const Chromosone* chromo) {
+    
+    TTScore score;
+    bool essential;
+    
+    for (hash_map<Student*,int>::const_iterator it = chromo->_lookup.begin(); it!=chromo->_lookup.end(); it++ )
+        scoreStudent(chromo, (*it).first, (*it).second, essential, &score);
+    
+    if ( scoresStability() ) {
+        for (int i=0; i<(int)chromo->_values.size(); i++)
+            scorePrevSlot(chromo, i, &score);
+    }
+    
+    return score;
 }
 
-void Chromosone::RejectMutation() {
-    _lookup = _backupLookup; // Restore backup hashmap then call method to reject rest
-    _backupLookup.clear();
-   	GaMultiValueChromosome<list<Student*> >::RejectMutation();
+TTObjectiveVector TTFitness::objectives(const Chromosone* chromo) {
+    
+    TTScore exact = score(chromo);
+    
+    TTObjectiveVector objectives;
+    for (int i = 0; i < TT_NUM_OBJECTIVES; i++) objectives[i] = (float)exact.units[i] / SCORE_UNITS;
+    
+    return objectives;
 }
 
+const char* TTFitness::getName(TTObjective objective) {
+    switch (objective) {
+        case TT_OBJ_OVERLAP: return "overlap";
+        case TT_OBJ_PROFICIENCY: return "proficiency";
+        case TT_OBJ_AVAILABILITY: return "availability";
+        case TT_OBJ_GROUPING: return "grouping";
+        case TT_OBJ_PAIRING: return "pairing";
+        case TT_OBJ_PREV_TUTOR: return "prev tutor";
+        case TT_OBJ_STABILITY: return "stability";
+        default: return "?";
+    }
+}
 
-
-// Randomly move some (mutation size) students to different (random) slots
-void TTMutation::operator ()(GaChromosome* parent) const
-{
-    Chromosone* chromo = dynamic_cast<Chromosone*>(parent);
+TTBreakdown TTFitness::breakdown(const Chromosone* chromo) {
     
-    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&chromo->GetParameters());
+    TTBreakdown breakdown;
+    bool essential;
     
-    int numSlots = (int)chromo->_values.size();
-    int numStudents = (int)chromo->_lookup.size();
+    for (hash_map<Student*,int>::const_iterator it = chromo->_lookup.begin(); it!=chromo->_lookup.end(); it++ )
+        scoreStudent(chromo, (*it).first, (*it).second, essential, NULL, &breakdown);
     
-    // Swap two students instead of doing a move with a probability of ProbSwap
-
-    bool swap = GaGlobalRandomBoolGenerator->Generate( params->getProbSwap() );
+    if ( scoresStability() ) {
+        for (int i=0; i<(int)chromo->_values.size(); i++)
+            scorePrevSlot(chromo, i, NULL, &breakdown);
+    }
     
-    if (!swap) {
-        //for each mutation:
-        for (int i = chromo->GetParameters().GetMutationSize() ; i>0; i--)
-        {
-            // pick a random student
-            int student = GaGlobalRandomIntegerGenerator->Generate(numStudents-1);
-            hash_map<Student*, int>::iterator it;
-            
-            // Iterate through the hashmap _lookup, reducing student and increasing it until student == 0:
-            //   now it points to a randomly chosen student.
-            for (it = chromo->_lookup.begin();
-                 student != 0 && it != chromo->_lookup.end();
-                 it++, student--) ;
+    return breakdown;
+}
 
-            Student* theStudent = (*it).first;
-            int oldSlot = (*it).second;
+const char* TTFitness::getName(TTCriterion criterion) {
+    switch (criterion) {
+        case TT_CRIT_OVERLAP: return "overlap";
+        case TT_CRIT_PROFICIENCY: return "proficiency";
+        case TT_CRIT_TUTOR_AVAILABILITY: return "tutor availability";
+        case TT_CRIT_STUDENT_AVAILABILITY: return "student availability";
+        case TT_CRIT_ENGAGEMENTS: return "engagements";
+        case TT_CRIT_GROUPING: return "grouping";
+        case TT_CRIT_PAIRING: return "pairing";
+        case TT_CRIT_PREV_TUTOR: return "prev tutor";
+        case TT_CRIT_STABILITY: return "stability";
+        default: return "?";
+    }
+}
 
-            //pick a random new slot:
-            int newSlot = GaGlobalRandomIntegerGenerator->Generate(numSlots-1);
-            
-            //delete from old:
-            list<Student*>& theOldSlot = chromo->_values[oldSlot];
-            for (list<Student*>::iterator itOld = theOldSlot.begin(); itOld != theOldSlot.end(); itOld++) {
-                if ( *itOld == theStudent )
-                {
-                    theOldSlot.erase(itOld);
-                    break;
-                }
-            }
-            
-            //add to new:
-            list<Student*>& theNewSlot = chromo->_values[newSlot];
-            theNewSlot.push_back(theStudent);
-            
-            //update hashmap:
-            chromo->_lookup[theStudent] = newSlot;
-            
-        }
-    } else {
-        
-        // pick 2 random students
-        int student1 = GaGlobalRandomIntegerGenerator->Generate(numStudents-1);
-        int student2 = GaGlobalRandomIntegerGenerator->Generate(numStudents-1);
-        hash_map<Student*, int>::iterator it1;
-        hash_map<Student*, int>::iterator it2;
-        
-        // Iterate through the hashmap _lookup, reducing student and increasing it1 until student == 0:
-        //   now it points to a randomly chosen student.
-        for (it1 = chromo->_lookup.begin();
-             student1 != 0 && it1 != chromo->_lookup.end();
-             it1++, student1--) ;
-        
-        // Same for it2
-        for (it2 = chromo->_lookup.begin();
-             student2 != 0 && it2 != chromo->_lookup.end();
-             it2++, student2--) ;
-        
-        Student* firstStu = (*it1).first;
-        Student* secondStu = (*it2).first;
-        int slot1 = (*it1).second;
-        int slot2 = (*it2).second;
-        
-        
-        //Delete stu1 from first slot and insert stu2
-        list<Student*>& theFirstSlot = chromo->_values[slot1];
-        for (list<Student*>::iterator itFirst = theFirstSlot.begin(); itFirst != theFirstSlot.end(); itFirst++) {
-            if ( *itFirst == firstStu )
-            {
-                theFirstSlot.erase(itFirst);
-                theFirstSlot.push_back(secondStu);
-                break;
-            }
-        }
-        
-        // Vice versa
-        list<Student*>& theSecondSlot = chromo->_values[slot2];
-        for (list<Student*>::iterator itSecond = theSecondSlot.begin(); itSecond != theSecondSlot.end(); itSecond++) {
-            if ( *itSecond == secondStu )
-            {
-                theSecondSlot.erase(itSecond);
-                theSecondSlot.push_back(firstStu);
-                break;
-            }
-        }
-        
-        //update hashmap:
-        chromo->_lookup[firstStu] = slot2;
-        chromo->_lookup[secondStu] = slot1;
-        
+TTObjective TTFitness::getObjective(TTCriterion criterion) {
+    switch (criterion) {
+        case TT_CRIT_OVERLAP:
+        case TT_CRIT_ENGAGEMENTS: return TT_OBJ_OVERLAP;
+        case TT_CRIT_PROFICIENCY: return TT_OBJ_PROFICIENCY;
+        case TT_CRIT_TUTOR_AVAILABILITY:
+        case TT_CRIT_STUDENT_AVAILABILITY: return TT_OBJ_AVAILABILITY;
+        case TT_CRIT_GROUPING: return TT_OBJ_GROUPING;
+        case TT_CRIT_PAIRING: return TT_OBJ_PAIRING;
+        case TT_CRIT_PREV_TUTOR: return TT_OBJ_PREV_TUTOR;
+        default: return TT_OBJ_STABILITY;
     }
-    
+}
+
+float TTFitness::maxScore(const Chromosone* chromo) {
+    return (float)maxUnits(chromo) / SCORE_UNITS;
+}
 
+long long TTFitness::maxUnits(const Chromosone* chromo) {
+    
+    Configuration& config = Configuration::getInstance();
+    
+    // Worked out once for the students and weights: see Configuration::processMaxUnits
+    long long maxscore = config.getMaxStudentUnits();
+    
+    if ( scoresStability() )
+        maxscore += config.getWeights().units[TT_CRIT_STABILITY] * ( (int)chromo->_values.size() - config.getChangedSlots() );
     
+    return maxscore;
+}
+
+float TTFitness::fitness(const Chromosone* chromo, const TTScore& score) {
+    return (float)( (double)score.total() / maxUnits(chromo) );
 }
 
 float TTFitness::operator()(GaChromosome* chromosome) const{
     Chromosone* chromo = dynamic_cast<Chromosone*>(chromosome);
     
-    float score = 0;
-    
-    int numStudents = (int)chromo->_lookup.size();
-    int numSlots = SLOTS_IN_DAY * Configuration::getInstance().numTutors();
+    TTScore score;
     
-    float maxscore = 6.1 * numStudents;
+    int numSlots = (int)chromo->_values.size();
     
     // loop over all students
     for (hash_map<Student*,int>::iterator it = chromo->_lookup.begin(); it!=chromo->_lookup.end(); it++ ) {
@@ -306,207 +1187,125 @@ float TTFitness::operator()(GaChromosome* chromosome) const{
         // meets essential reqs?
         bool essential = true;
         
-        //is there overlapping?
-        if ( !(chromo->_values[(*it).second].size()>1) ) score+=1.5;
-        else essential = false;
-            // Overlapping is particularly bad, so should merit a higher penalty than other lacking major requirements, eg not teaching the subject
-        
-        //Does the tutor teach the subject? (And how well?)
-        //get tutor and time:
-        div_t division = div((*it).second, SLOTS_IN_DAY);
-        int tutorID = division.quot + 1;
-        int time = division.rem;
-        
-        Tutor* tutor = Configuration::getInstance().getTutor(tutorID);
-        
-        //check subject:
-        map<Subject*, float> tutSubjs = tutor->getSubjects();
-        bool foundTutor = false;
-        for (map<Subject*, float>::iterator itTut = tutSubjs.begin(); itTut != tutSubjs.end(); itTut++)
-        {
-            Subject* studentSubject = (*it).first->getSubject();
-            if ( studentSubject == (*itTut).first )
-            {
-                // If the tutor teaches the subject, increment the score by the tutor's proficiency in this subject
-                score += (*itTut).second;
-                foundTutor=true;
-                break;
-            }
-        }
-        if (!foundTutor) essential=false;
-        
-        //can the tutor do the time?
-        bool canDoTut = true;
-        list<int> tutNotSlots = tutor->getNotSlots();
-        for (list<int>::iterator itTut = tutNotSlots.begin(); itTut != tutNotSlots.end(); itTut++)
-        {
-            if ( *itTut == (*it).second )
-            {
-                canDoTut = false;
-                essential=false;
-                break;
-            }
-        }
-        if (canDoTut) score++;
-        
-        //can the student do the time?
-        bool canDoStu = true;
-        list<int> stuNotSlots = (*it).first->getNotTimes();
-        
-        for (list<int>::iterator itStu = stuNotSlots.begin(); itStu != stuNotSlots.end(); itStu++)
-        {
-            if ( *itStu == time )
-            {
-                canDoStu = false;
-                essential=false;
-                break;
-            }
-        }
-        if (canDoStu) score++;
-        
-        //is this student already busy at this time?
-        int engagements = 0;
-        //loop over all tutors at this time
-        for (int i = time; i < numSlots; i += SLOTS_IN_DAY)
-        {
-            list<Student*> thisSlot= chromo->_values[i];
-            list<Student*>::iterator search;
-            for (search = thisSlot.begin(); search != thisSlot.end(); search++) {
-                 // If we find a student with the same baseID (ie the same person) who has an appointment at this time:
-                if ( (*search)->getBaseID() == (*it).first->getBaseID() ) engagements++;
-            }
-        }
-        if (engagements==1) score++; // If we only found them once (ie in the slot we were considering) then score
-        else essential=false;        
-        
-        
-        // Are all the other appointments of this student in the same group?
-        //    score for every appointment in the same group
-        int samegroup = -1;
-        // n.b. starts on -1 since we will find at least one student in this group: the one that we're currently iterating on!
-        
-        // Calculate start and end of times to search
-        int loopStart, loopEnd;
-        
-        if (time < SLOTS_IN_DAY/3) loopStart = 0;
-        else if (time < SLOTS_IN_DAY*2/3) loopStart = SLOTS_IN_DAY/3;
-        else loopStart = SLOTS_IN_DAY*2/3;
-        
-        loopEnd = loopStart+(SLOTS_IN_DAY/3);
-        
-        // loop over all tutors:
-        for (int tutorBase = 0; tutorBase < numSlots; tutorBase += SLOTS_IN_DAY) {
-            // loop over the segment of times
-            for (int loopTime = loopStart; loopTime < loopEnd; loopTime++) {
-                int slot = tutorBase + loopTime;
-                
-                list<Student*> thisSlot = chromo->_values[slot];
-                list<Student*>::iterator search;
-                for (search = thisSlot.begin(); search != thisSlot.end(); search++) {
-                    // If we find a student with the same baseID (ie the same person) in this same group:
-                    if ( (*search)->getBaseID() == (*it).first->getBaseID() ) samegroup++;
-                }
-            }
-        }
-        score += samegroup * 0.5/6.0;
-        if (samegroup != (*it).first->getNoInterviews() - 1 ) essential = false;
-        
-//         this score is so small because we must consider what happens when a student's / tutor's notTime conflicts with the grouping:
-//             if we have four students grouped in the slots that the student can't do, we require that moving one student out of the group is profitable
-//             the gain is +1 (since we're no longer breaching a notTime
-//             the loss is x for each other slot in the group (3 in this example) + 3x for the slot being moved (since there were three others in the same group)
-//             hence we require that 6x < 1. I chose 6x = 0.5.
-        maxscore += ( (*it).first->getNoInterviews() - 1 ) * 0.5/6.0;
-        
-       
-        
-        //  MINOR:
-        //   Does this student/tutor pair appear elsewhere in this timetable?
-        int pairings=0;
-        //loop over all tutor's slots
-        for (int i = SLOTS_IN_DAY*(tutorID-1); i < SLOTS_IN_DAY*tutorID; i++) {
-            list<Student*> thisSlot= chromo->_values[i];
-            list<Student*>::iterator search;
-            for (search = thisSlot.begin(); search != thisSlot.end(); search++) {
-                // If we find a student with the same baseID (ie the same person) paired with the same tutor:
-                if ( (*search)->getBaseID() == (*it).first->getBaseID() ) pairings++;
-            }
-        }
-        // This is a minor requirement, therefore, if the student is only paired with this tutor
-        //   once then score a small prize, so other req. take precidence
-        if (pairings==1) score+=0.5;
-        
-        //  MINOR:
-        //   Has the tutor been seen previously in another session?
-        bool seenPrev = false;
-        list<Tutor*> prevTutors = (*it).first->getPrevTutors();
-        for (list<Tutor*>::iterator itPrev = prevTutors.begin(); itPrev != prevTutors.end(); itPrev++)
-        {
-            if ( *itPrev == tutor ) {
-                seenPrev = true;
-                break;
-            }
-        }
-        if (!seenPrev) score+=0.1;
-        
-        
+        scoreStudent(chromo, (*it).first, (*it).second, essential, &score);
         
         // mark whether the essential criteria were met or not:
         chromo->_essentialMet[(*it).first] = essential;
         
     }
     
-    // MINOR:
-    //  Is this the same solution that we found in the last run (if there was one)?
-    //  Score for this is very low since we want all other requirements to take priority
-    if (Configuration::getInstance().prevSolutionLoaded()) {
-        
-#define PREV_SCORE 0.01
-        
-        vector<list<int> > prevSolution = Configuration::getInstance().getPrevSolution();
-        
+    if ( scoresStability() ) {
         //loop over all slots
-        for (int i=0; i<numSlots; i++) {
-            
-            list<Student*> thisSlot = chromo->_values[i];
-            
-            // If we're out of range of prevSolution then treat it as an empty slot: i.e. reward if thisSlot is also empty
-            if ( i >= prevSolution.size() ) {
-                if (thisSlot.empty())
-                    score += PREV_SCORE;
-                
-                continue;
-            }
-            
-            
-            list<int> prevSlot = prevSolution[i];
-            
-            bool matching = true;
-            if (thisSlot.empty()) {
-                if (!prevSlot.empty())
-                    matching = false;
-            }
-            else {
-                
-                // For each student in this slot,
-                //   check if they're in the previous solution
-                for (list<Student*>::iterator it = thisSlot.begin(); it!=thisSlot.end(); it++) {
-                    // If this student is not present, set matching = false and break
-                    if ( find(prevSlot.begin(), prevSlot.end(), (*it)->getBaseID()) == prevSlot.end() ) {
-                        matching = false;
-                        break;
-                    }
-                }
-            }
-            
-            if (matching) score += PREV_SCORE;
+        for (int i=0; i<numSlots; i++)
+            scorePrevSlot(chromo, i, &score);
+    }
+    
+    chromo->_score = score;
+    
+    return fitness(chromo, score);
+}
 
-        }
+TTScore TTFitness::partialScore(const Chromosone* chromo, const vector<Student*>& students, const vector<int>& slots) {
+    
+    TTScore score;
+    bool essential;
+    
+    for (vector<Student*>::const_iterator it = students.begin(); it != students.end(); it++)
+        scoreStudent(chromo, *it, chromo->getSlot(*it), essential, &score);
+    
+    if ( scoresStability() ) {
+        for (vector<int>::const_iterator it = slots.begin(); it != slots.end(); it++)
+            scorePrevSlot(chromo, *it, &score);
+    }
+    
+    return score;
+}
+
+void TTFitness::addAffected(const Chromosone* chromo, const TTMove& move, vector<Student*>& affected, vector<int>& slots) {
+    
+    // A student's score depends only on the occupancy of their own slot and on where the other
+    //   students with the same baseID are, so only these need rescoring
+    const vector<Student*>& siblings = Configuration::getInstance().getConstraints(move.student).siblings;
+    for (vector<Student*>::const_iterator it = siblings.begin(); it != siblings.end(); it++)
+        addUnique(affected, *it);
+    
+    if (move.other) {
+        const vector<Student*>& otherSiblings = Configuration::getInstance().getConstraints(move.other).siblings;
+        for (vector<Student*>::const_iterator it = otherSiblings.begin(); it != otherSiblings.end(); it++)
+            addUnique(affected, *it);
+    }
+    
+    int moveSlots[] = { move.fromSlot, move.toSlot };
+    
+    for (int i = 0; i < 2; i++) {
+        if ( find(slots.begin(), slots.end(), moveSlots[i]) != slots.end() ) continue;
+        slots.push_back(moveSlots[i]);
         
-        maxscore += PREV_SCORE * ( numSlots - Configuration::getInstance().getChangedSlots() );
+        const list<Student*>& occupants = chromo->_values[moveSlots[i]];
+        for (list<Student*>::const_iterator it = occupants.begin(); it != occupants.end(); it++)
+            addUnique(affected, *it);
+    }
+}
+
+TTScore TTFitness::moveGain(Chromosone* chromo, const TTMove& move) {
+    
+    vector<Student*> affected;
+    vector<int> slots;
+    
+    addAffected(chromo, move, affected, slots);
+    
+    TTScore before = partialScore(chromo, affected, slots);
+    chromo->applyMove(move);
+    TTScore after = partialScore(chromo, affected, slots);
+    
+    return after - before;
+}
+
+TTScore TTFitness::movesGain(Chromosone* chromo, const vector<TTMove>& moves) {
+    
+    vector<Student*> affected;
+    vector<int> slots;
+    
+    // Everyone affected must be found before anything moves, since occupants are read from the current slots
+    for (vector<TTMove>::const_iterator it = moves.begin(); it != moves.end(); it++)
+        addAffected(chromo, *it, affected, slots);
+    
+    TTScore before = partialScore(chromo, affected, slots);
+    chromo->applyMoves(moves);
+    TTScore after = partialScore(chromo, affected, slots);
+    
+    return after - before;
+}
+
+int TTScoreComparator::compare(const TTScore& a, const TTScore& b) {
+    
+    for (int i = 0; i < TT_NUM_TIERS; i++) {
+        long long difference = a.tier( (TTTier)i ) - b.tier( (TTTier)i );
+        if (difference) return difference > 0 ? 1 : -1;
+    }
+    
+    return 0;
+}
+
+bool TTScoreProgressCriteria::Evaluate(const GaAlgorithm& algorithm, const GaStopCriteriaParams& parameters) const {
+    
+    const TTScoreProgressCriteriaParams& p = (const TTScoreProgressCriteriaParams&)parameters;
+    const GaStatistics& statistics = algorithm.GetAlgorithmStatistics();
+    
+    const GaChromosomePtr& best = statistics.GetBestChromosome();
+    if ( best.IsNULL() ) return false;
+    
+    const TTScore& score = dynamic_cast<const Chromosone&>(*best).getScore();
+    int generation = statistics.GetCurrentGeneration();
+    
+    if ( !p._started || generation < p._lastProgress || TTScoreComparator::compare( score, p._best ) > 0 ) {
+        p._started = true;
+        p._best = score;
+        p._lastProgress = generation;
+        return false;
     }
     
-    return (float)score / (float)maxscore;
+    return generation - p._lastProgress >= p._historyDepth;
 }
 
 
@@ -516,14 +1315,30 @@ GaChromosomePtr TTCrossover::operator ()(const GaChromosome* parent1, const GaCh
     const Chromosone* c1 = dynamic_cast<const Chromosone*>( parent1 );
     const Chromosone* c2 = dynamic_cast<const Chromosone*>( parent2 );
     
-    Chromosone* n = new Chromosone(*c1, true);
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&c1->GetParameters());
     
-    // number of students
-    int size = (int)c1->_lookup.size();
+    return crossover( c1, c2, params->getCrossoverMode() );
+}
+
+GaChromosomePtr TTCrossover::crossover(const Chromosone* c1, const Chromosone* c2, TTCrossoverMode mode) const
+{
+    vector<int> stacked;
+    GaChromosomePtr child = (mode == TT_CROSSOVER_GROUP) ? groupCrossover(c1, c2, stacked) : pointCrossover(c1, c2, stacked);
     
+    Chromosone* n = dynamic_cast<Chromosone*>( child.GetRawPtr() );
+    n->inheritStrategy(*c1, *c2);
+    
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&c1->GetParameters());
+    if ( params->getRepair() ) params->getRepair()->repair(n, stacked);
+    
+    return child;
+}
+
+vector<bool> TTCrossover::crossoverPoints(int size, int numberOfPoints)
+{
 	// determine crossover point (randomly)
 	vector<bool> cp( size );
-	for( int i = c1->GetParameters().GetNumberOfCrossoverPoints(); i > 0; i-- )
+	for( int i = min( numberOfPoints, size ); i > 0; i-- )
 	{
 		while( 1 )
 		{
@@ -536,6 +1351,19 @@ GaChromosomePtr TTCrossover::operator ()(const GaChromosome* parent1, const GaCh
 		}
 	}
     
+    return cp;
+}
+
+GaChromosomePtr TTCrossover::pointCrossover(const Chromosone* c1, const Chromosone* c2, vector<int>& stacked) const
+{
+    Chromosone* n = new Chromosone(*c1, true);
+    
+    // number of students
+    int size = (int)c1->_lookup.size();
+    
+	// determine crossover point (randomly)
+	vector<bool> cp = crossoverPoints( size, c1->GetParameters().GetNumberOfCrossoverPoints() );
+    
     
     //copy hashmaps into vector so that we are sure to have both iterating in the same order
     vector< pair<Student*, int> > vec1;
@@ -582,6 +1410,7 @@ GaChromosomePtr TTCrossover::operator ()(const GaChromosome* parent1, const GaCh
 			n->_lookup.insert( pair<Student*, int>( vec1[i].first, vec1[i].second ) );
 			// add to corresponding slot
 			n->_values[ vec1[i].second ].push_back( vec1[i].first );
+			if ( n->_values[ vec1[i].second ].size() == 2 ) stacked.push_back( vec1[i].second );
 		}
 		else
 		{
@@ -589,6 +1418,7 @@ GaChromosomePtr TTCrossover::operator ()(const GaChromosome* parent1, const GaCh
 			n->_lookup.insert( pair<Student*, int>( vec2[i].first, vec2[i].second ) ); // here's a crash
 			// add to corresponding slot
 			n->_values[ vec2[i].second ].push_back( vec2[i].first );
+			if ( n->_values[ vec2[i].second ].size() == 2 ) stacked.push_back( vec2[i].second );
 		}
         
 		// crossover point
@@ -600,4 +1430,130 @@ GaChromosomePtr TTCrossover::operator ()(const GaChromosome* parent1, const GaCh
     return n;
 }
 
+// Crossover that treats each student (i.e. all the interviews with the same baseID) as a unit, so that a
+//   student's interviews keep the relative arrangement they had in the parent they came from
+GaChromosomePtr TTCrossover::groupCrossover(const Chromosone* c1, const Chromosone* c2, vector<int>& stacked) const
+{
+    Chromosone* n = new Chromosone(*c1, true);
+    
+    // Get the first interview of each student, in the config's order
+    const vector<Student*>& students = Configuration::getInstance().getStudentVector();
+    vector<Student*> leaders;
+    for (vector<Student*>::const_iterator it = students.begin(); it != students.end(); it++) {
+        if ( Configuration::getInstance().getConstraints(*it).siblings.front() == *it )
+            leaders.push_back(*it);
+    }
+    
+    int size = (int)leaders.size();
+    
+	// determine crossover point (randomly)
+	vector<bool> cp = crossoverPoints( size, c1->GetParameters().GetNumberOfCrossoverPoints() );
+    
+	// make new code by combining parent codes, a whole student at a time
+	bool first = GaGlobalRandomBoolGenerator->Generate();
+	for( int i = 0; i < size; i++ )
+	{
+        const Chromosone* parent = first ? c1 : c2;
+        const vector<Student*>& siblings = Configuration::getInstance().getConstraints( leaders[i] ).siblings;
+        
+        for (vector<Student*>::const_iterator it = siblings.begin(); it != siblings.end(); it++) {
+            int slot = parent->getSlot(*it);
+            n->_lookup.insert( pair<Student*, int>( *it, slot ) );
+            n->_values[ slot ].push_back( *it );
+            if ( n->_values[ slot ].size() == 2 ) stacked.push_back( slot );
+        }
+        
+		// crossover point
+		if( cp[ i ] )
+			// change source chromosome
+			first = !first;
+	}
+    
+    // Light repair: where students from the two parents have landed in the same slot, move the extras
+    //   to where they were in the other parent, if that slot is free in the child
+    for (vector<int>::iterator itSlot = stacked.begin(); itSlot != stacked.end(); itSlot++) {
+        
+        int slot = *itSlot;
+        
+        list<Student*> extras( ++n->_values[slot].begin(), n->_values[slot].end() );
+        
+        for (list<Student*>::iterator it = extras.begin(); it != extras.end(); it++) {
+            int otherSlot = ( c1->getSlot(*it) == slot ) ? c2->getSlot(*it) : c1->getSlot(*it);
+            
+            if ( n->_values[otherSlot].empty() )
+                n->applyMove( TTMove( *it, slot, otherSlot ) );
+        }
+    }
+    
+    return n;
+}
+
 
+GaChromosomePtr TTBlockCrossover::operator ()(const GaChromosome* parent1, const GaChromosome* parent2) const
+{
+    const Chromosone* c1 = dynamic_cast<const Chromosone*>( parent1 );
+    const Chromosone* c2 = dynamic_cast<const Chromosone*>( parent2 );
+    
+    Chromosone* n = new Chromosone(*c1, true);
+    
+    int numSlots = (int)c1->_values.size();
+    int numTutors = numSlots / SLOTS_IN_DAY;
+    
+    // Inherit by tutor rows or by time columns?
+    bool byRow = GaGlobalRandomBoolGenerator->Generate();
+    
+    // Choose a parent for each block
+    vector<bool> fromFirst( byRow ? numTutors : SLOTS_IN_DAY );
+    for (int i = 0; i < (int)fromFirst.size(); i++)
+        fromFirst[i] = GaGlobalRandomBoolGenerator->Generate();
+    
+    // Copy the blocks over. A student already placed from the other parent's blocks isn't placed again.
+    //   Note any slot that ends up stacked, for the repair
+    vector<int> stacked;
+    for (int slot = 0; slot < numSlots; slot++) {
+        
+        div_t division = div(slot, SLOTS_IN_DAY);
+        const Chromosone* parent = fromFirst[ byRow ? division.quot : division.rem ] ? c1 : c2;
+        
+        const list<Student*>& source = parent->_values[slot];
+        for (list<Student*>::const_iterator it = source.begin(); it != source.end(); it++) {
+            if ( n->_lookup.insert( pair<Student*, int>( *it, slot ) ).second )
+                n->_values[slot].push_back(*it);
+        }
+        
+        if ( n->_values[slot].size() > 1 ) stacked.push_back(slot);
+    }
+    
+    // Put back anyone who's missing: where either parent had them if that slot is free, otherwise in a random empty slot
+    vector<int> emptySlots;
+    for (int slot = 0; slot < numSlots; slot++)
+        if ( n->_values[slot].empty() ) emptySlots.push_back(slot);
+    
+    const vector<Student*>& students = Configuration::getInstance().getStudentVector();
+    for (vector<Student*>::const_iterator it = students.begin(); it != students.end(); it++) {
+        
+        if ( n->_lookup.find(*it) != n->_lookup.end() ) continue;
+        
+        int slot = c1->getSlot(*it);
+        if ( !n->_values[slot].empty() ) slot = c2->getSlot(*it);
+        
+        // Pick random empty slots until we find one that's still empty. Each is removed once tried, so this stays linear
+        while ( !n->_values[slot].empty() && !emptySlots.empty() ) {
+            int i = GaGlobalRandomIntegerGenerator->Generate( (int)emptySlots.size() - 1 );
+            slot = emptySlots[i];
+            emptySlots[i] = emptySlots.back();
+            emptySlots.pop_back();
+        }
+        
+        n->_lookup.insert( pair<Student*, int>( *it, slot ) );
+        n->_values[slot].push_back(*it);
+        if ( n->_values[slot].size() == 2 ) stacked.push_back(slot);
+    }
+    
+    n->inheritStrategy(*c1, *c2);
+    
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>(&c1->GetParameters());
+    if ( params->getRepair() ) params->getRepair()->repair(n, stacked);
+    
+    return n;
+}
@@ -11,7 +11,9 @@
 
 #include "Student.h"
 #include "Configuration.h"
+#include "TTWeights.h"
 #include <ext/hash_map>
+#include <array>
 using namespace __gnu_cxx;
 
 #include "GLSource/Initialization.h"
@@ -26,31 +28,240 @@ using namespace __gnu_cxx;
 #include "GLSource/StopCriterias.h"
 #include "GLSource/IncrementalAlgorithm.h"
 
+// How TTCrossover combines its parents
+enum TTCrossoverMode {
+    TT_CROSSOVER_POINT,     // n-point crossover over individual student-interviews
+    TT_CROSSOVER_GROUP      // n-point crossover over students, keeping all interviews with the same baseID together
+};
+
+// The neighbourhood operators that TTMutation and the local search solvers can use
+enum TTOperator {
+    TT_OP_MOVE,             // move a student to a random slot
+    TT_OP_SWAP,             // swap two students' slots
+    TT_OP_EJECTION_CHAIN,   // move A into B's slot, B into C's slot, ... and the last back into A's old slot
+    TT_OP_KEMPE_CHAIN,      // swap a connected group of interviews between two times, each keeping their tutor
+    TT_NUM_OPERATORS
+};
+
+// Relative weights with which each operator is chosen
+class TTOperatorSet {
+    
+    double _weights[TT_NUM_OPERATORS];
+    
+public:
+    
+    // Moves and swaps only, swapping with probability probSwap
+    TTOperatorSet(double probSwap) {
+        for (int i = 0; i < TT_NUM_OPERATORS; i++) _weights[i] = 0;
+        _weights[TT_OP_MOVE] = 1 - probSwap;
+        _weights[TT_OP_SWAP] = probSwap;
+    }
+    
+    inline double getWeight(TTOperator op) const { return _weights[op]; }
+    inline void setWeight(TTOperator op, double weight) { _weights[op] = weight; }
+    
+    // Choose an operator in proportion to the weights, given a random number in [0, 1)
+    TTOperator choose(double random) const;
+};
+
+// How MakeNewFromPrototype fills in a new chromosome (after the previous solution, if any, has been seeded)
+enum TTInitMode {
+    TT_INIT_RANDOM,         // every student in a uniformly random slot
+    TT_INIT_GREEDY,         // most constrained students first, each in the best slot left for them, ties broken randomly
+    TT_INIT_DSATUR,         // DSATUR colouring of the clash graph: interviews with the fewest times left get a time first, then a tutor
+    TT_INIT_MATCHING,       // from a maximum matching of interviews to slots. Used for the seeds, see Chromosone::nextInitMode
+    TT_INIT_PREVIOUS,       // the previous solution, if one was loaded
+    TT_INIT_CARRIED         // a timetable kept from the last run, see TimetablerInst::keepPopulation
+};
+
+class TTOperatorScheduler;
+class TTRepair;
+
 class TTChromosomeParams : public GaChromosomeParams {
     
     // The probability of swapping two students in a mutation instead of randomly moving as normal
     double _probSwap;
     
+    TTCrossoverMode _crossoverMode;
+    
+    // Which operators a mutation uses. Starts off as just moves and swaps, according to probSwap
+    TTOperatorSet _operators;
+    
+    // Maximum number of students an ejection or Kempe chain can involve
+    int _chainDepth;
+    
+    // If set, chooses the operators adaptively instead of using _operators' fixed weights. Not owned by the parameters
+    TTOperatorScheduler* _scheduler;
+    
+    // If set, the crossovers use it to unstack the students that their children have sharing a slot. Not owned by the parameters
+    TTRepair* _repair;
+    
+    // Standard deviation of the log-normal perturbation applied to each chromosome's own mutation
+    //   probability, size and probSwap every time it's mutated. 0 keeps them fixed at the values above.
+    //   probSwap is only used, and so only adapted, when there's no scheduler
+    double _selfAdaptationRate;
+    
+    TTInitMode _initMode;
+    
+    // Seed for building the starting population in parallel, see TTPopulationInitializer. 0 to seed from the global generator
+    unsigned long _initSeed;
+    
 public:
     
-    // Initialise TTChromosomeParams with probSwap and the parent's variables
-    TTChromosomeParams(float mutationProbability, int mutationSize, double mutationProbSwap, bool improvingOnlyMutations, float crossoverProbability, int numberOfCrossoverPoints) :
-    _probSwap(mutationProbSwap),
+    // Initialise TTChromosomeParams with probSwap, the crossover mode and the parent's variables
+    TTChromosomeParams(float mutationProbability, int mutationSize, double mutationProbSwap, bool improvingOnlyMutations, float crossoverProbability, int numberOfCrossoverPoints, TTCrossoverMode crossoverMode = TT_CROSSOVER_POINT) :
     GaChromosomeParams(mutationProbability,
                        mutationSize,
                        improvingOnlyMutations,
                        crossoverProbability,
-                       numberOfCrossoverPoints) {}
+                       numberOfCrossoverPoints),
+    _probSwap(mutationProbSwap),
+    _crossoverMode(crossoverMode),
+    _operators(mutationProbSwap),
+    _chainDepth(4),
+    _scheduler(NULL),
+    _repair(NULL),
+    _selfAdaptationRate(0),
+    _initMode(TT_INIT_RANDOM),
+    _initSeed(0) {}
+    
+    // Deleted through TTChromosomeParams pointers, by TimetablerInst
+    virtual ~TTChromosomeParams() {}
     
     inline double getProbSwap() const { return _probSwap; }
     
+    inline TTCrossoverMode getCrossoverMode() const { return _crossoverMode; }
+    inline void setCrossoverMode(TTCrossoverMode mode) { _crossoverMode = mode; }
     
+    inline const TTOperatorSet& getOperators() const { return _operators; }
+    inline void setOperatorWeight(TTOperator op, double weight) { _operators.setWeight(op, weight); }
+    
+    inline int getChainDepth() const { return _chainDepth; }
+    inline void setChainDepth(int depth) { _chainDepth = depth; }
+    
+    inline TTOperatorScheduler* getScheduler() const { return _scheduler; }
+    inline void setScheduler(TTOperatorScheduler* scheduler) { _scheduler = scheduler; }
+    
+    inline TTRepair* getRepair() const { return _repair; }
+    inline void setRepair(TTRepair* repair) { _repair = repair; }
+    
+    inline double getSelfAdaptationRate() const { return _selfAdaptationRate; }
+    inline void setSelfAdaptationRate(double rate) { _selfAdaptationRate = rate; }
+    
+    inline TTInitMode getInitMode() const { return _initMode; }
+    inline void setInitMode(TTInitMode mode) { _initMode = mode; }
+    
+    inline unsigned long getInitSeed() const { return _initSeed; }
+    inline void setInitSeed(unsigned long seed) { _initSeed = seed; }
+    
+};
+
+// One step in the mutation neighbourhood: student goes from fromSlot to toSlot and, for a swap,
+// other goes the opposite way (other is NULL for a plain move)
+struct TTMove {
+    Student* student;
+    int fromSlot;
+    int toSlot;
+    Student* other;
+    
+    TTMove(Student* s, int from, int to, Student* o = NULL) : student(s), fromSlot(from), toSlot(to), other(o) {}
+};
+
+// The criteria the score is made up of, as objectives for the multi-objective mode (see TTMultiObjective.h).
+//   Each is the criterion's part of the score, so they're all maximised and add up to the score
+enum TTObjective {
+    TT_OBJ_OVERLAP,         // nobody else in the slot, and the student has nothing else on at the time
+    TT_OBJ_PROFICIENCY,     // the tutor teaches the subject, and how well
+    TT_OBJ_AVAILABILITY,    // both the tutor and the student can do the time
+    TT_OBJ_GROUPING,        // the student's interviews are in the same session
+    TT_OBJ_PAIRING,         // the student sees each tutor once
+    TT_OBJ_PREV_TUTOR,      // the student hasn't seen the tutor before
+    TT_OBJ_STABILITY,       // slots match the previous solution
+    TT_NUM_OBJECTIVES
+};
+
+typedef array<float, TT_NUM_OBJECTIVES> TTObjectiveVector;
+
+// What timetables are ranked on, most important first: a timetable is better than another if it does better on
+//   the first tier they differ on, whatever the rest add up to (see TTScoreComparator)
+enum TTTier {
+    TT_TIER_HARD,           // clashes
+    TT_TIER_ESSENTIAL,      // the rest of the essential criteria
+    TT_TIER_MINOR,          // the minor ones
+    TT_TIER_STABILITY,      // matching the previous solution
+    TT_NUM_TIERS
+};
+
+// A score in SCORE_UNITS, split up by criterion
+struct TTScore {
+    
+    long long units[TT_NUM_OBJECTIVES];
+    
+    TTScore() { for (int i = 0; i < TT_NUM_OBJECTIVES; i++) units[i] = 0; }
+    
+    inline long long total() const {
+        long long sum = 0;
+        for (int i = 0; i < TT_NUM_OBJECTIVES; i++) sum += units[i];
+        return sum;
+    }
+    
+    // The tiers, in order of importance: clashes, then the rest of the essential criteria, then the minor ones,
+    //   then matching the previous solution
+    inline long long hard() const { return units[TT_OBJ_OVERLAP]; }
+    inline long long essential() const { return units[TT_OBJ_PROFICIENCY] + units[TT_OBJ_AVAILABILITY]; }
+    inline long long minor() const { return units[TT_OBJ_GROUPING] + units[TT_OBJ_PAIRING] + units[TT_OBJ_PREV_TUTOR]; }
+    inline long long stability() const { return units[TT_OBJ_STABILITY]; }
+    
+    inline long long tier(TTTier tier) const {
+        switch (tier) {
+            case TT_TIER_HARD: return hard();
+            case TT_TIER_ESSENTIAL: return essential();
+            case TT_TIER_MINOR: return minor();
+            default: return stability();
+        }
+    }
+    
+    inline TTScore& operator+=(const TTScore& other) {
+        for (int i = 0; i < TT_NUM_OBJECTIVES; i++) units[i] += other.units[i];
+        return *this;
+    }
+    
+    inline TTScore operator-(const TTScore& other) const {
+        TTScore difference(*this);
+        for (int i = 0; i < TT_NUM_OBJECTIVES; i++) difference.units[i] -= other.units[i];
+        return difference;
+    }
+};
+
+// How a timetable does on each criterion: how many times it's met out of how many it's checked, and what it adds
+//   to the score. See TTFitness::breakdown
+struct TTBreakdown {
+    
+    int met[TT_NUM_CRITERIA];
+    int of[TT_NUM_CRITERIA];
+    long long units[TT_NUM_CRITERIA];   // in SCORE_UNITS
+    
+    TTBreakdown() {
+        for (int i = 0; i < TT_NUM_CRITERIA; i++) {
+            met[i] = of[i] = 0;
+            units[i] = 0;
+        }
+    }
+    
+    inline void add(TTCriterion criterion, bool isMet, long long score) {
+        of[criterion]++;
+        if (isMet) met[criterion]++;
+        units[criterion] += score;
+    }
+    
+    inline float getPoints(TTCriterion criterion) const { return (float)units[criterion] / SCORE_UNITS; }
 };
 
 class Chromosone : public GaMultiValueChromosome<list<Student*> > {
     
     friend class TTMutation;
     friend class TTCrossover;
+    friend class TTBlockCrossover;
     friend class TTFitness;
     
     hash_map<Student*, int> _lookup;
@@ -59,6 +270,16 @@ class Chromosone : public GaMultiValueChromosome<list<Student*> > {
     // map holding whether the essential criteria have been met for a student (updated when fitness is calculated)
     map<Student*, bool> _essentialMet;
     
+    // The exact score the fitness was worked out from, kept up to date along with it
+    TTScore _score;
+    TTScore _backupScore;
+    
+    // This chromosome's own mutation parameters. They start off as the ones in TTChromosomeParams and
+    //   adapt themselves from there: see Mutation()
+    float _mutationProbability;
+    float _mutationSize;
+    float _probSwap;
+    
 public:
     
     Chromosone(GaChromosomeDomainBlock<list<Student*> >* configBlock);
@@ -71,6 +292,19 @@ public:
     
 	virtual GaChromosomePtr MakeNewFromPrototype() const;
     
+    // How the next chromosome made from this prototype should be filled in: the previous solution first (if loaded),
+    //   then any timetables kept from the last run, then any matching seeds still wanted, then the parameters' mode.
+    //   Not thread-safe, since it counts the seeds
+    TTInitMode nextInitMode() const;
+    
+    // Make a new chromosome from this prototype, filled in by mode using the given generators. carried is which kept
+    //   timetable to start from for TT_INIT_CARRIED. Can be called from several threads at once, as long as each has
+    //   its own generators
+    GaChromosomePtr makeNew(TTInitMode mode, GaRandomInteger* randomInteger, GaRandomFloat* randomFloat, int carried = 0) const;
+    
+    // Perturb this chromosome's mutation parameters, then mutate according to them
+    virtual void Mutation();
+    
 	virtual void PreapareForMutation(); // Spelling mistake in the framework! Might fix later
     
 	virtual void AcceptMutation();
@@ -83,9 +317,65 @@ public:
 	// Return reference to array of time-space slots
 	inline const vector<list<Student*> >& GetSlots() const { return _values; }
     
+    // Get the slot a student is currently in
+    inline int getSlot(Student* s) const { return (*_lookup.find(s)).second; }
+    
+    inline const TTScore& getScore() const { return _score; }
+    
+    inline float getMutationProbability() const { return _mutationProbability; }
+    inline int getMutationSize() const { return max( 1, (int)(_mutationSize + 0.5F) ); }
+    inline float getProbSwap() const { return _probSwap; }
+    
+    // Take the average of the parents' mutation parameters (geometric for the probability and size)
+    void inheritStrategy(const Chromosone& parent1, const Chromosone& parent2);
+    
+    // Carry out / reverse a move, keeping _values and _lookup in step
+    void applyMove(const TTMove& move);
+    void undoMove(const TTMove& move);
+    
+    // Carry out a sequence of moves in order / reverse them in the opposite order
+    void applyMoves(const vector<TTMove>& moves);
+    void undoMoves(const vector<TTMove>& moves);
+    
+private:
+    
+    // Take student s out of slot from and put them in slot to
+    void relocate(Student* s, int from, int to);
+    
+    // Multiply each mutation parameter by exp(rate * N(0,1)), keeping them within sensible bounds. probSwap is left
+    //   alone if there's a scheduler, since it picks between moves and swaps itself
+    void perturbStrategy(double rate, GaRandomFloat* random);
+    
+    // Fill an empty chromosome according to the initialization mode
+    void constructPrevious(GaRandomInteger* random);
+    void constructRandom(GaRandomInteger* randomInteger);
+    void constructGreedy(GaRandomInteger* randomInteger, GaRandomFloat* randomFloat);
+    
+    // Fill an empty chromosome from a maximum matching of interviews to slots, see TTMatching.h
+    void constructMatching(GaRandomFloat* randomFloat);
+    
+    // Fill an empty chromosome by colouring the graph of clashes between a student's interviews with times
+    void constructDSatur(GaRandomInteger* randomInteger, GaRandomFloat* randomFloat);
+    
+    // Fill an empty chromosome from a timetable kept from before the configuration changed, given as the baseIDs in
+    //   each slot. Slots that no longer exist and students who've gone are dropped, anyone new goes in a random slot
+    //   they can do, and then anyone sharing a slot is moved out as by TTRepair
+    void constructCarried(const vector<list<int> >& layout, GaRandomInteger* randomInteger);
+    
+    // Score that student would earn in slot, as in TTFitness::scoreStudent but counting only the students placed so far
+    float greedyScore(Student* student, int slot) const;
+    
 };
 
 
+// Which third of the day (session) a time falls in
+inline int sessionOf(int time) {
+    if (time < SLOTS_IN_DAY/3) return 0;
+    else if (time < SLOTS_IN_DAY*2/3) return 1;
+    else return 2;
+}
+
+
 class TTFitness : public GaFitnessOperation
 {
 public:
@@ -95,6 +385,129 @@ public:
 	virtual GaParameters* GACALL MakeParameters() const { return NULL; }
     
 	virtual bool GACALL CheckParameters(const GaParameters& parameters) const { return true; }
+    
+    // Score earned by one student-interview sitting in the given slot, with the configuration's weights. essential is
+    // set to false if any of the essential criteria are not met. If score is given, the student's score is added to it
+    // exactly, and if breakdown is, each criterion the student is checked on
+    static float scoreStudent(const Chromosone* chromo, Student* student, int slot, bool& essential, TTScore* score = NULL, TTBreakdown* breakdown = NULL);
+    
+    // Score for a slot matching the previous solution. Only meaningful if scoresStability.
+    //   If score or breakdown are given, it's added to them as in scoreStudent
+    static float scorePrevSlot(const Chromosone* chromo, int slot, TTScore* score = NULL, TTBreakdown* breakdown = NULL);
+    
+    // Are slots scored on matching the previous solution: was one loaded, and is stability given any weight?
+    static bool scoresStability();
+    
+    // The exact score of the whole timetable
+    static TTScore score(const Chromosone* chromo);
+    
+    // The score split up by criterion, in points. Adds up to the (unnormalised) score
+    static TTObjectiveVector objectives(const Chromosone* chromo);
+    
+    // Short name for displaying the objective
+    static const char* getName(TTObjective objective);
+    
+    // How chromo does on each criterion. Not kept up to date as the fitness is, so only work it out when it's wanted
+    static TTBreakdown breakdown(const Chromosone* chromo);
+    
+    // Short name for displaying the criterion
+    static const char* getName(TTCriterion criterion);
+    
+    // The objective the criterion's score counts towards
+    static TTObjective getObjective(TTCriterion criterion);
+    
+    // The score of a perfect timetable: the fitness is the score divided by this. In points, and exactly in SCORE_UNITS
+    static float maxScore(const Chromosone* chromo);
+    static long long maxUnits(const Chromosone* chromo);
+    
+    // The fitness of a timetable of chromo's size with the given score. Always the same for the same score
+    static float fitness(const Chromosone* chromo, const TTScore& score);
+    
+    // Apply move to chromo and return the exact change in score. Only the students
+    // and slots that the move touches are rescored
+    static TTScore moveGain(Chromosone* chromo, const TTMove& move);
+    
+    // As moveGain, for a sequence of moves
+    static TTScore movesGain(Chromosone* chromo, const vector<TTMove>& moves);
+    
+    // As moveGain and movesGain, in (unnormalised) points
+    static inline float moveDelta(Chromosone* chromo, const TTMove& move) { return (float)moveGain(chromo, move).total() / SCORE_UNITS; }
+    static inline float movesDelta(Chromosone* chromo, const vector<TTMove>& moves) { return (float)movesGain(chromo, moves).total() / SCORE_UNITS; }
+    
+private:
+    
+    // scoreStudent, with only the minor terms in Terms (TTTerm flags) scored, and the rest left out altogether
+    template <int Terms>
+    static float scoreStudentWith(const Chromosone* chromo, Student* student, int slot, bool& essential, TTScore* score, TTBreakdown* breakdown);
+    
+    // scoreStudentWith for each set of terms, indexed by the flags
+    typedef float (*StudentScorer)(const Chromosone*, Student*, int, bool&, TTScore*, TTBreakdown*);
+    static const StudentScorer _plans[TT_NUM_PLANS];
+    
+    // Add the students and slots whose score move can change to affected and slots
+    static void addAffected(const Chromosone* chromo, const TTMove& move, vector<Student*>& affected, vector<int>& slots);
+    
+    // Score of the given students and slots, as counted by operator()
+    static TTScore partialScore(const Chromosone* chromo, const vector<Student*>& students, const vector<int>& slots);
+};
+
+// The fitness comparator for timetables. Timetables are ranked on their exact scores, tier by tier (see TTTier):
+// clashes first, then the rest of the essential criteria, then the minor ones, then stability. The population sorts
+// by this too, so its best timetable is the best by these rules. Bare fitnesses, which are just the total score,
+// are only compared where there's nothing else to go on
+class TTScoreComparator : public GaFitnessComparator {
+    
+public:
+    
+    virtual int GACALL operator ()(float fitness1, float fitness2) const { return (int)( fitness1 > fitness2 ) - (int)( fitness1 < fitness2 ); }
+    
+    virtual int GACALL operator ()(const GaChromosome& chromosome1, const GaChromosome& chromosome2) const { return compare(chromosome1, chromosome2); }
+    
+    // 1 if a beats b, -1 if b beats a, 0 if they score exactly the same on every tier
+    static int compare(const TTScore& a, const TTScore& b);
+    
+    // Compare two chromosomes by their exact scores
+    static inline int compare(const GaChromosome& a, const GaChromosome& b) {
+        return compare( dynamic_cast<const Chromosone&>(a).getScore(), dynamic_cast<const Chromosone&>(b).getScore() );
+    }
+};
+
+// The usual stop criterion's parameters: how many generations the best timetable may go without improving
+class TTScoreProgressCriteriaParams : public GaStopCriteriaParams {
+    
+    friend class TTScoreProgressCriteria;
+    
+    int _historyDepth;
+    
+    // The best score so far and the generation it was reached in. GAL keeps its criteria's history in their
+    //   parameters, which the algorithm holds its own copy of
+    mutable bool _started;
+    mutable TTScore _best;
+    mutable int _lastProgress;
+    
+public:
+    
+    TTScoreProgressCriteriaParams(int historyDepth) : _historyDepth(historyDepth), _started(false), _lastProgress(0) {}
+    TTScoreProgressCriteriaParams() : _historyDepth(50000), _started(false), _lastProgress(0) {}
+    
+    virtual GaParameters* GACALL Clone() const { return new TTScoreProgressCriteriaParams(*this); }
+    
+    inline int getHistoryDepth() const { return _historyDepth; }
+};
+
+// Stops the algorithm once its best timetable (see GaStatistics::GetBestChromosome) hasn't improved for the history
+// depth's number of generations. Improvement is measured on the exact scores by TTScoreComparator, so it's measured in
+// the order the population ranks by: any gain counts however small, and a gain in a more important tier counts even
+// if it costs fitness. A run that starts again from generation 0 starts the count again
+class TTScoreProgressCriteria : public GaStopCriteria {
+    
+public:
+    
+    virtual bool GACALL Evaluate(const GaAlgorithm& algorithm, const GaStopCriteriaParams& parameters) const;
+    
+    virtual GaParameters* GACALL MakeParameters() const { return new TTScoreProgressCriteriaParams(); }
+    
+    virtual bool GACALL CheckParameters(const GaParameters& parameters) const { return ( (const TTScoreProgressCriteriaParams&) parameters ).getHistoryDepth() > 0; }
 };
 
 
@@ -107,6 +520,31 @@ public:
 	virtual GaParameters* GACALL MakeParameters() const { return NULL; }
     
 	virtual bool GACALL CheckParameters(const GaParameters& parameters) const { return true; }
+    
+    // Mutate chromo as operator() does and return the exact change in score
+    static TTScore mutate(Chromosone* chromo);
+    
+    // Pick a random move (or swap, if swap is true) for chromo without applying it. Students only move to the rows
+    //   of their own component's tutors (see Configuration::getComponents), and only swap with its other students.
+    // Callers running in their own thread can pass their own generator to avoid contending on the global one
+    static TTMove randomMove(const Chromosone* chromo, bool swap, GaRandomInteger* random = GaGlobalRandomIntegerGenerator);
+    
+    // Replace moves with a random instance of operator op for chromo, without applying it.
+    //   Chains involve at most depth students
+    static void randomMoves(const Chromosone* chromo, TTOperator op, int depth, vector<TTMove>& moves, GaRandomInteger* random = GaGlobalRandomIntegerGenerator);
+    
+private:
+    
+    static void ejectionChain(const Chromosone* chromo, int depth, vector<TTMove>& moves, GaRandomInteger* random);
+    
+    static void kempeChain(const Chromosone* chromo, int depth, vector<TTMove>& moves, GaRandomInteger* random);
+    
+    // Pick a random slot in the rows of the student's component's tutors, or anywhere if nobody teaches their subject
+    static int componentSlot(const Chromosone* chromo, Student* student, GaRandomInteger* random);
+    
+    // Pick a random slot for the student in their component, preferring one with a tutor who teaches their subject
+    //   at a time they can both do
+    static int suitableSlot(const Chromosone* chromo, Student* student, GaRandomInteger* random);
 
 };
 
@@ -123,6 +561,34 @@ public:
     
 	virtual bool GACALL CheckParameters(const GaParameters& parameters) const { return true; }
     
+    // Cross the parents over using the given mode, regardless of the one in the parameters
+    GaChromosomePtr crossover(const Chromosone* c1, const Chromosone* c2, TTCrossoverMode mode) const;
+    
+private:
+    
+    // Each adds the slots it leaves with more than one student in to stacked, once each, for TTRepair
+    GaChromosomePtr pointCrossover(const Chromosone* c1, const Chromosone* c2, vector<int>& stacked) const;
+    
+    GaChromosomePtr groupCrossover(const Chromosone* c1, const Chromosone* c2, vector<int>& stacked) const;
+    
+    // Randomly choose numberOfPoints crossover points out of size positions
+    static vector<bool> crossoverPoints(int size, int numberOfPoints);
+};
+
+// Crossover over the slot matrix (one row per tutor, one column per time): the child takes each whole tutor row,
+//   or each whole time column, from one parent or the other. Students that end up in the child twice keep their
+//   first place and students that end up missing are put back where a parent had them, in linear time
+class TTBlockCrossover : public GaCrossoverOperation
+{
+    
+public:
+    
+	virtual GaChromosomePtr GACALL operator ()(const GaChromosome* parent1,
+                                               const GaChromosome* parent2) const;
+    
+	virtual GaParameters* GACALL MakeParameters() const { return NULL; }
+    
+	virtual bool GACALL CheckParameters(const GaParameters& /*parameters*/) const { return true; }
     
 };
 
@@ -0,0 +1,80 @@
+//
+//  TTCoupling.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTCoupling.h"
+
+#include "GLsource/Population.h"
+
+void TTBestOfCoupling::operator ()(const GaPopulation& population, GaCouplingResultSet& output, const GaCouplingParams& parameters,
+                                   int workerId, int numberOfWorkers) const
+{
+    const TTBestOfCouplingParams* params = dynamic_cast<const TTBestOfCouplingParams*>(&parameters);
+    int candidates = params ? params->GetOffspringsPerParentPair() : 1;
+    bool stopEarly = params ? params->getStopEarly() : false;
+    
+    GaSortedGroup& parents = output.GetSelectionResultSet().SelectedGroup();
+    int size = parents.GetCurrentSize();
+    
+    // Share the children out between the workers as GaSimpleCoupling does, keeping pairs together
+    int lim = min( parameters.GetNumberOfOffsprings(), output.GetNumberOfOffsprings() );
+    
+    int outSize = lim / numberOfWorkers;
+    if (outSize % 2) outSize++;
+    int outStart = outSize * workerId;
+    
+    if (workerId == numberOfWorkers - 1) outSize = lim - outStart;
+    lim = outStart + outSize;
+    
+    for (int i = outStart; i < lim; i += 2) {
+        
+        // Out of time: leave the rest of this worker's children out
+        if ( chrono::steady_clock::now() >= _deadline ) {
+            for (int j = i; j < lim; j++)
+                output.SetOffspringAt( j, GaChromosomePtr::NullPtr, -1 );
+            break;
+        }
+        
+        int pi1 = parents[ i % size ];
+        int pi2 = parents[ (i + 1) % size ];
+        
+        GaChromosomePtr p1 = population.GetAt( pi1 ).GetChromosome();
+        GaChromosomePtr p2 = population.GetAt( pi2 ).GetChromosome();
+        
+        produce( population, p1, p2, output, i, pi1, candidates, stopEarly, parameters.GetCheckForDuplicates() );
+        if (i + 1 < lim)
+            produce( population, p2, p1, output, i + 1, pi2, candidates, stopEarly, parameters.GetCheckForDuplicates() );
+    }
+    
+    output.SetClearDuplicates( parameters.GetCheckForDuplicates() );
+}
+
+void TTBestOfCoupling::produce(const GaPopulation& population, GaChromosomePtr parent1, GaChromosomePtr parent2, GaCouplingResultSet& output,
+                               int offspringIndex, int parentIndex, int candidates, bool stopEarly, bool checkDuplicates) const
+{
+    const GaChromosome& worseParent = TTScoreComparator::compare( *parent1, *parent2 ) < 0 ? *parent1 : *parent2;
+    
+    GaChromosomePtr best;
+    
+    for (int i = 0; i < candidates; i++) {
+        
+        // Chromosone::Mutation scores the mutation by its change in score, so only the crossover needs a full evaluation
+        GaChromosomePtr candidate = parent1->Crossover( parent2 );
+        candidate->Mutation();
+        
+        if ( best.IsNULL() || TTScoreComparator::compare( *candidate, *best ) > 0 )
+            best = candidate;
+        
+        if ( stopEarly && TTScoreComparator::compare( *best, worseParent ) > 0 )
+            break;
+    }
+    
+    if ( !checkDuplicates || !CheckForDuplicates( population, *best ) )
+        output.SetOffspringAt( offspringIndex, best, parentIndex );
+    else
+        output.SetOffspringAt( offspringIndex, GaChromosomePtr::NullPtr, -1 );
+}
@@ -0,0 +1,75 @@
+//
+//  TTCoupling.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTCoupling__
+#define __Timetabler__TTCoupling__
+
+#include <iostream>
+#include <chrono>
+
+#include "TTChromosone.h"
+#include "GLsource/CouplingOperations.h"
+
+using namespace Population::CouplingOperations;
+
+// Parameters for TTBestOfCoupling. GetOffspringsPerParentPair() is the number of candidate children made per child wanted
+class TTBestOfCouplingParams : public GaMulitpleCrossoverCouplingParams {
+    
+    // Stop making candidates for a child as soon as one is fitter than the worse of its parents
+    bool _stopEarly;
+    
+public:
+    
+    TTBestOfCouplingParams(int numberOfOffsprings, bool checkForDuplicates, int candidates, bool stopEarly) :
+    GaMulitpleCrossoverCouplingParams(numberOfOffsprings, checkForDuplicates, max(1, candidates)),
+    _stopEarly(stopEarly) {}
+    
+    TTBestOfCouplingParams() : _stopEarly(true) {}
+    
+    virtual GaParameters* GACALL Clone() const { return new TTBestOfCouplingParams( *this ); }
+    
+    inline bool getStopEarly() const { return _stopEarly; }
+};
+
+// Pairs up parents as GaSimpleCoupling does, but makes up to GetOffspringsPerParentPair() candidates
+// (crossover then mutation) for each child and keeps the fittest. The workers share out the children,
+// so each worker evaluates its own children's candidates in parallel with the others. A child's candidates
+// are made one after another on the same worker so that the early stop can cut them short.
+// Once past the deadline, if one's set, no more children are started, so a generation overruns it by at most one child.
+class TTBestOfCoupling : public GaCouplingOperation {
+    
+    chrono::steady_clock::time_point _deadline;
+    
+public:
+    
+    TTBestOfCoupling() : _deadline( chrono::steady_clock::time_point::max() ) {}
+    
+    // Set or clear the deadline. Only while the algorithm isn't running
+    inline void setDeadline(chrono::steady_clock::time_point deadline) { _deadline = deadline; }
+    inline void clearDeadline() { _deadline = chrono::steady_clock::time_point::max(); }
+    
+    virtual void GACALL operator ()(const GaPopulation& population,
+                                    GaCouplingResultSet& output,
+                                    const GaCouplingParams& parameters,
+                                    int workerId,
+                                    int numberOfWorkers) const;
+    
+    virtual GaParameters* GACALL MakeParameters() const { return new TTBestOfCouplingParams(); }
+    
+    virtual bool GACALL CheckParameters(const GaParameters& parameters) const {
+        return ( (const GaCouplingParams&) parameters ).GetNumberOfOffsprings() > 0;
+    }
+    
+private:
+    
+    // Make the best of up to candidates children of parent1 and parent2, and store it in output at offspringIndex
+    void produce(const GaPopulation& population, GaChromosomePtr parent1, GaChromosomePtr parent2, GaCouplingResultSet& output,
+                 int offspringIndex, int parentIndex, int candidates, bool stopEarly, bool checkDuplicates) const;
+};
+
+#endif /* defined(__Timetabler__TTCoupling__) */
@@ -0,0 +1,264 @@
+//
+//  TTExact.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTExact.h"
+
+// Before the branch and bound, each kind of large neighbourhood is destroyed and repaired this many times, to give
+//   the search a good timetable to beat from the start
+#define POLISH_ITERATIONS 100
+#define POLISH_MAX_FREED 8
+#define POLISH_MAX_NODES 100000
+
+// Root of x's tree in a union-find forest, halving the path on the way
+static int findRoot(vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[ parent[x] ];
+        x = parent[x];
+    }
+    return x;
+}
+
+TTExactResult TTExactAlgorithm::solve(const Chromosone* start, long long maxNodes, const TTKnownScore* known, const atomic<bool>* cancel) {
+    
+    Chromosone* current = new Chromosone( *start, false );
+    
+    for (int i = 0; i < TT_LNS_NEIGHBOURHOODS && !( cancel && *cancel ); i++) {
+        Chromosone* polished = TTNeighbourhoodSearch::search( current, (TTNeighbourhood)i, POLISH_ITERATIONS, POLISH_MAX_FREED, POLISH_MAX_NODES, i + 1, cancel );
+        if (polished) {
+            delete current;
+            current = polished;
+        }
+    }
+    
+    // Keep the polished timetable in case tidying it up leaves it worse than the searches can make up for
+    Chromosone* polished = new Chromosone( *current, false );
+    if ( tidy(current) ) current->RefreshFitness();
+    
+    vector<vector<Student*> > students;
+    vector<vector<int> > slots;
+    decompose( current, students, slots );
+    
+    // All in one piece: free everyone, anywhere, as the score elsewhere is only any use for the whole timetable
+    if (students.size() == 1) {
+        slots[0].resize( current->GetSlots().size() );
+        for (int i = 0; i < (int)slots[0].size(); i++) slots[0][i] = i;
+    }
+    
+    // Otherwise search each part on a thread of its own. They don't touch each other's students or slots, so
+    //   the best of each together is the best there is
+    vector<TTBranchAndBound*> searches;
+    vector<future<bool> > solving;
+    
+    for (int i = 0; i < (int)students.size(); i++) {
+        TTBranchAndBound* search = new TTBranchAndBound( current, students[i], slots[i] );
+        const TTKnownScore* elsewhere = students.size() == 1 ? known : NULL;
+        
+        searches.push_back(search);
+        solving.push_back( async( launch::async, [search, maxNodes, elsewhere, cancel]() { return search->solve(maxNodes, elsewhere, cancel); } ) );
+    }
+    
+    TTExactResult result = { current, true, 0 };
+    
+    for (int i = 0; i < (int)searches.size(); i++) {
+        if ( solving[i].get() ) searches[i]->apply(current);
+        
+        result.optimal = result.optimal && searches[i]->isComplete();
+        result.nodes += searches[i]->getNodes();
+        delete searches[i];
+    }
+    
+    // Which also means the searches can't have found the best there is
+    if ( TTScoreComparator::compare( *polished, *current ) > 0 ) {
+        delete current;
+        result.best = polished;
+        result.optimal = false;
+    }
+    else delete polished;
+    
+    return result;
+}
+
+bool TTExactAlgorithm::tidy(Chromosone* chromo) {
+    
+    Configuration& config = Configuration::getInstance();
+    const vector<SubjectComponent>& components = config.getComponents();
+    const vector<Student*>& students = config.getStudentVector();
+    const vector<list<Student*> >& slots = chromo->GetSlots();
+    
+    bool moved = false;
+    
+    for (vector<Student*>::const_iterator it = students.begin(); it != students.end(); it++) {
+        const StudentConstraints& constraints = config.getConstraints(*it);
+        int slot = chromo->getSlot(*it);
+        
+        if ( constraints.component < 0 || config.componentOfTutor( slot / SLOTS_IN_DAY ) == constraints.component ) continue;
+        
+        // The first empty slot they can do, or failing that the first empty one
+        const vector<int>& tutors = components[constraints.component].tutors;
+        int to = -1;
+        
+        for (vector<int>::const_iterator t = tutors.begin(); t != tutors.end(); t++) {
+            for (int time = 0; time < SLOTS_IN_DAY; time++) {
+                int candidate = *t * SLOTS_IN_DAY + time;
+                if ( !slots[candidate].empty() ) continue;
+                
+                if (to < 0) to = candidate;
+                if ( constraints.canDoSlot[candidate] ) {
+                    to = candidate;
+                    break;
+                }
+            }
+            if ( to >= 0 && constraints.canDoSlot[to] ) break;
+        }
+        
+        if (to < 0) continue;
+        
+        chromo->applyMove( TTMove( *it, slot, to ) );
+        moved = true;
+    }
+    
+    return moved;
+}
+
+void TTExactAlgorithm::decompose(const Chromosone* chromo, vector<vector<Student*> >& students, vector<vector<int> >& slots) {
+    
+    Configuration& config = Configuration::getInstance();
+    const vector<SubjectComponent>& components = config.getComponents();
+    const vector<Student*>& all = config.getStudentVector();
+    int nTutors = config.numTutors();
+    
+    // Join up each component's tutors, and each student's tutor now with the tutors of their component
+    vector<int> parent( nTutors );
+    for (int t = 0; t < nTutors; t++) parent[t] = t;
+    
+    for (vector<SubjectComponent>::const_iterator it = components.begin(); it != components.end(); it++)
+        for (int k = 1; k < (int)(*it).tutors.size(); k++)
+            parent[ findRoot( parent, (*it).tutors[k] ) ] = findRoot( parent, (*it).tutors[0] );
+    
+    for (vector<Student*>::const_iterator it = all.begin(); it != all.end(); it++) {
+        int component = config.getConstraints(*it).component;
+        if (component >= 0)
+            parent[ findRoot( parent, chromo->getSlot(*it) / SLOTS_IN_DAY ) ] = findRoot( parent, components[component].tutors[0] );
+    }
+    
+    // Each tree with anyone in it is a part, holding everyone sat with its tutors
+    vector<int> partOfRoot( nTutors, -1 );
+    students.clear();
+    slots.clear();
+    
+    for (vector<Student*>::const_iterator it = all.begin(); it != all.end(); it++) {
+        int root = findRoot( parent, chromo->getSlot(*it) / SLOTS_IN_DAY );
+        
+        if ( partOfRoot[root] < 0 ) {
+            partOfRoot[root] = (int)students.size();
+            students.push_back( vector<Student*>() );
+            slots.push_back( vector<int>() );
+        }
+        students[ partOfRoot[root] ].push_back(*it);
+    }
+    
+    for (int t = 0; t < nTutors; t++) {
+        int part = partOfRoot[ findRoot(parent, t) ];
+        if (part < 0) continue;
+        
+        for (int time = 0; time < SLOTS_IN_DAY; time++)
+            slots[part].push_back( t * SLOTS_IN_DAY + time );
+    }
+}
+
+void TTExactAlgorithm::Initialize() {
+    
+    discardSolving();
+    _finished = false;
+    _optimal = false;
+    _nodes = 0;
+    
+    TTIncrementalAlgorithm::Initialize();
+    
+    int interviews = Configuration::getInstance().largestComponent();
+    _exact = interviews > 0 && interviews <= _exactLimit;
+    
+    if (_exact) startSolving();
+}
+
+void TTExactAlgorithm::startSolving() {
+    
+    GaChromosomePtr best;
+    GetPopulation(0).GetBestChromosomes( &best, 0, 1 );
+    
+    // The search gets its own copy, as for relinking
+    Chromosone* start = new Chromosone( dynamic_cast<const Chromosone&>( *best ), false );
+    long long maxNodes = _maxNodes;
+    
+    _known.clear();
+    _known.raise( start->getScore() );
+    const TTKnownScore* known = &_known;
+    atomic<bool>* cancel = &_cancel;
+    
+    _solving = async( launch::async, [start, maxNodes, known, cancel]() {
+        TTExactResult result = solve( start, maxNodes, known, cancel );
+        delete start;
+        return result;
+    } );
+}
+
+void TTExactAlgorithm::AfterWorkers() {
+    
+    // Keep the search up to date with the best the GA's found
+    GaChromosomePtr best;
+    GetPopulation(0).GetBestChromosomes( &best, 0, 1 );
+    _known.raise( dynamic_cast<const Chromosone&>( *best ).getScore() );
+    
+    if ( _solving.valid() && _solving.wait_for( chrono::seconds(0) ) == future_status::ready ) {
+        TTExactResult result = _solving.get();
+        
+        _finished = true;
+        _nodes = result.nodes;
+        _optimal = result.optimal;
+        
+        offer( result.best );
+    }
+    
+    TTIncrementalAlgorithm::AfterWorkers();
+}
+
+bool TTExactAlgorithm::CheckStopCriteria() {
+    
+    if (!_optimal) return TTIncrementalAlgorithm::CheckStopCriteria();
+    
+    if (_state == GAS_RUNNING) {
+        _state = GAS_CRITERIA_STOPPED;
+        
+        // raise state change event
+        _observers.EvolutionStateChanged( _state, *this );
+    }
+    
+    discardBackground();
+    return true;
+}
+
+bool TTExactAlgorithm::OnResume() {
+    
+    // Called before the threads start again, so nothing else is touching the search
+    if ( _exact && !_finished && !_solving.valid() ) startSolving();
+    
+    return TTIncrementalAlgorithm::OnResume();
+}
+
+void TTExactAlgorithm::discardBackground() {
+    discardSolving();
+    TTIncrementalAlgorithm::discardBackground();
+}
+
+void TTExactAlgorithm::discardSolving() {
+    if ( !_solving.valid() ) return;
+    
+    _cancel = true;
+    delete _solving.get().best;
+    _cancel = false;
+}
@@ -0,0 +1,117 @@
+//
+//  TTExact.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTExact__
+#define __Timetabler__TTExact__
+
+#include <iostream>
+#include <future>
+#include <atomic>
+
+#include "TTIncremental.h"
+#include "TTBranchAndBound.h"
+
+// What the exact search found
+struct TTExactResult {
+    Chromosone* best;   // the best timetable it found
+    bool optimal;       // whether it searched the whole tree, proving nothing beats best or the score it was told of
+    long long nodes;
+};
+
+// The GA, which also solves exactly when the configuration's components (see Configuration::processComponents) are
+// small enough. That's decided each time the run starts, from whatever configuration's loaded by then, and if they
+// aren't it's just the incremental GA. Otherwise, as soon as the population's been made, a branch and bound over every student and every slot (see TTBranchAndBound)
+// starts on a thread of its own, from the best starting timetable polished by a few rounds of large neighbourhood
+// search. If the timetable splits into independent parts, each gets a search and a thread of its own instead. The
+// GA runs as normal meanwhile, and after each generation tells a single search the score of its best, which the
+// search then only looks for timetables to beat, so the two together prove optimality much sooner than either could.
+// When the search finishes, its timetable is offered to the population, and if it searched the whole tree the run
+// stops there, since nothing can do better. If it gave up, the GA just carries on. Stopping the run cancels the
+// search along with the rest of the background work, and resuming it starts a new one if it hadn't finished.
+class TTExactAlgorithm : public TTIncrementalAlgorithm {
+    
+    // Largest number of student-interviews in any one component for which to search, and whether this run does
+    int _exactLimit;
+    bool _exact;
+    
+    // Most nodes the search may visit before giving up. 0 for no limit
+    long long _maxNodes;
+    
+    // The running search, and the score of the population's best for it to beat
+    future<TTExactResult> _solving;
+    TTKnownScore _known;
+    atomic<bool> _cancel;
+    
+    // Has the search finished, rather than been cancelled?
+    bool _finished;
+    
+    bool _optimal;
+    long long _nodes;
+    
+public:
+    
+    // Searches when no component has more than exactLimit interviews. 0 to never search
+    TTExactAlgorithm(GaPopulation* population, const GaMultithreadingAlgorithmParams& parameters, int exactLimit, long long maxNodes, bool pathRelinking, int searchWorkers, const TTRestartParams& restartParams) :
+    TTIncrementalAlgorithm(population, parameters, pathRelinking, searchWorkers, restartParams),
+    _exactLimit(exactLimit),
+    _exact(false),
+    _maxNodes(maxNodes),
+    _cancel(false),
+    _finished(false),
+    _optimal(false),
+    _nodes(0) {}
+    
+    virtual ~TTExactAlgorithm() { discardSolving(); }
+    
+    // Is this run searching, or just the GA?
+    inline bool isExact() const { return _exact; }
+    
+    // Has the best timetable been proven optimal?
+    inline bool isOptimal() const { return _optimal; }
+    
+    // Nodes the search visited, once it's finished
+    inline long long getNodes() const { return _nodes; }
+    
+    // Find the best timetable there is, starting from start. Gives up after maxNodes nodes (0 for no limit) in each
+    //   part (see decompose). If known is given, it's the score of a timetable found elsewhere, and if the timetable
+    //   is all in one part, only timetables beating it are looked for. If cancel is given, the search gives up
+    //   as soon as it's set
+    static TTExactResult solve(const Chromosone* start, long long maxNodes, const TTKnownScore* known = NULL, const atomic<bool>* cancel = NULL);
+    
+    // Split chromo's students into parts that can be solved independently as things stand, with the slots each part
+    //   may use. That's the configuration's components, joined together wherever someone's sat with a tutor from
+    //   a different component to their own
+    static void decompose(const Chromosone* chromo, vector<vector<Student*> >& students, vector<vector<int> >& slots);
+    
+protected:
+    
+    virtual void GACALL Initialize();
+    
+    virtual void GACALL AfterWorkers();
+    
+    // Stop as if by the stop criterion once the best is proven optimal
+    virtual bool GACALL CheckStopCriteria();
+    
+    virtual bool GACALL OnResume();
+    
+    virtual void discardBackground();
+    
+    // Cancel the search and throw away what it found
+    void discardSolving();
+    
+private:
+    
+    // Start a search from the population's best
+    void startSolving();
+    
+    // Move anyone sat with a tutor outside their component to an empty slot in it, where there's room, so that
+    //   the components can be searched apart. Returns whether anyone moved
+    static bool tidy(Chromosone* chromo);
+};
+
+#endif /* defined(__Timetabler__TTExact__) */
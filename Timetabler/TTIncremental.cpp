@@ -0,0 +1,309 @@
+//
+//  TTIncremental.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTIncremental.h"
+
+#include <thread>
+
+#include "GLsource/CouplingOperations.h"
+
+using namespace Population::CouplingOperations;
+
+// Each large neighbourhood search destroys and repairs this many neighbourhoods (in each component, if it's searching
+//   them apart), freeing at most LNS_MAX_FREED interviews each time and giving up on a repair after LNS_MAX_NODES nodes
+#define LNS_ITERATIONS 50
+#define LNS_MAX_FREED 8
+#define LNS_MAX_NODES 100000
+
+Chromosone* TTPathRelinking::relink(const Chromosone* initiating, const Chromosone* guiding, const atomic<bool>* cancel) {
+    
+    // The moves that turn initiating into guiding. Only the student itself is moved, so these stay valid whatever order they're made in
+    vector<TTMove> remaining;
+    for (hash_map<Student*, int>::const_iterator it = initiating->GetStudentLookup().begin(); it != initiating->GetStudentLookup().end(); it++) {
+        int target = guiding->getSlot( (*it).first );
+        if (target != (*it).second) remaining.push_back( TTMove( (*it).first, (*it).second, target ) );
+    }
+    
+    // The last move would reach guiding itself
+    if (remaining.size() < 2) return NULL;
+    
+    Chromosone* current = new Chromosone( *initiating, false );
+    
+    vector<TTMove> path;
+    TTScore score, bestScore;
+    size_t bestStep = 0;
+    
+    while (remaining.size() > 1) {
+        
+        if ( cancel && *cancel ) {
+            delete current;
+            return NULL;
+        }
+        
+        // Try every remaining move and make the best, by TTScoreComparator
+        size_t bestMove = 0;
+        TTScore bestGain;
+        
+        for (size_t i = 0; i < remaining.size(); i++) {
+            TTScore gain = TTFitness::moveGain( current, remaining[i] );
+            current->undoMove( remaining[i] );
+            
+            if (i == 0 || TTScoreComparator::compare( gain, bestGain ) > 0) {
+                bestGain = gain;
+                bestMove = i;
+            }
+        }
+        
+        current->applyMove( remaining[bestMove] );
+        path.push_back( remaining[bestMove] );
+        remaining[bestMove] = remaining.back();
+        remaining.pop_back();
+        
+        score += bestGain;
+        if (path.size() == 1 || TTScoreComparator::compare( score, bestScore ) > 0) {
+            bestScore = score;
+            bestStep = path.size();
+        }
+    }
+    
+    // Go back to the best timetable on the path
+    while (path.size() > bestStep) {
+        current->undoMove( path.back() );
+        path.pop_back();
+    }
+    
+    current->RefreshFitness();
+    
+    return current;
+}
+
+void TTIncrementalAlgorithm::Initialize() {
+    
+    discardRelinking();
+    _relinks = _relinksAccepted = 0;
+    
+    discardSearches();
+    _searchRound = _searchesDone = _searchesAccepted = 0;
+    
+    _restarts = 0;
+    _best = NULL;
+    _lastProgress = 0;
+    
+    TTPopulationInitializer::initialize( _population );
+}
+
+void TTIncrementalAlgorithm::AfterWorkers() {
+    
+    if (_pathRelinking) relinkElites();
+    
+    if ( !_searches.empty() ) searchNeighbourhoods();
+    
+    GaIncrementalAlgorithm::AfterWorkers();
+    
+    checkStagnation();
+}
+
+bool TTIncrementalAlgorithm::OnStop() {
+    
+    // The control thread's waiting for the state, so it won't start any more meanwhile
+    discardBackground();
+    
+    return GaIncrementalAlgorithm::OnStop();
+}
+
+bool TTIncrementalAlgorithm::CheckStopCriteria() {
+    
+    if ( !GaIncrementalAlgorithm::CheckStopCriteria() ) return false;
+    
+    discardBackground();
+    return true;
+}
+
+void TTIncrementalAlgorithm::discardBackground() {
+    discardRelinking();
+    discardSearches();
+}
+
+void TTIncrementalAlgorithm::SubscribeObserver(GaObserver* observer) {
+    GaIncrementalAlgorithm::SubscribeObserver(observer);
+    
+    TTRestartObserver* restartObserver = dynamic_cast<TTRestartObserver*>(observer);
+    if (restartObserver) _restartObservers.push_back(restartObserver);
+}
+
+void TTIncrementalAlgorithm::UnsubscribeObserver(GaObserver* observer) {
+    GaIncrementalAlgorithm::UnsubscribeObserver(observer);
+    
+    TTRestartObserver* restartObserver = dynamic_cast<TTRestartObserver*>(observer);
+    _restartObservers.erase( remove( _restartObservers.begin(), _restartObservers.end(), restartObserver ), _restartObservers.end() );
+}
+
+double TTIncrementalAlgorithm::diversity() const {
+    
+    GaChromosomePtr best;
+    if ( !_population->GetBestChromosomes( &best, 0, 1 ) ) return 0;
+    
+    const Chromosone* bestChromo = dynamic_cast<const Chromosone*>( best.GetRawPtr() );
+    const hash_map<Student*, int>& bestLookup = bestChromo->GetStudentLookup();
+    
+    double total = 0;
+    int counted = 0;
+    
+    for (int i = 0; i < _population->GetCurrentSize(); i++) {
+        const Chromosone* chromo = dynamic_cast<const Chromosone*>( _population->GetAt(i).GetChromosome().GetRawPtr() );
+        if (chromo == bestChromo) continue;
+        
+        int different = 0;
+        for (hash_map<Student*, int>::const_iterator it = bestLookup.begin(); it != bestLookup.end(); it++)
+            if ( chromo->getSlot( (*it).first ) != (*it).second ) different++;
+        
+        total += bestLookup.empty() ? 0 : (double)different / bestLookup.size();
+        counted++;
+    }
+    
+    return counted ? total / counted : 0;
+}
+
+void TTIncrementalAlgorithm::checkStagnation() {
+    
+    int generation = _population->GetStatistics().GetCurrentGeneration();
+    GaChromosomePtr best;
+    _population->GetBestChromosomes( &best, 0, 1 );
+    
+    // Ranked as the population ranks them, so an improvement in a more important tier counts even if it costs fitness
+    if ( _best.IsNULL() || TTScoreComparator::compare( *best, *_best ) > 0 ) {
+        _best = best;
+        _lastProgress = generation;
+        return;
+    }
+    
+    if ( _restarts >= _restartParams.getMaxRestarts() || generation - _lastProgress < _restartParams.getStagnation() ) return;
+    
+    // Only worth restarting if the population has lost its variety. Otherwise leave it another stagnation period
+    double currentDiversity = diversity();
+    _lastProgress = generation;
+    
+    if ( currentDiversity >= _restartParams.getMinDiversity() ) return;
+    
+    _restarts++;
+    TTPopulationInitializer::reseed( _population, _restartParams.getElites(), _restarts );
+    
+    for (vector<TTRestartObserver*>::iterator it = _restartObservers.begin(); it != _restartObservers.end(); it++)
+        (*it)->PopulationRestarted( _restarts, currentDiversity, *this );
+}
+
+void TTIncrementalAlgorithm::relinkElites() {
+    
+    if ( _relinking.valid() ) {
+        
+        if ( _relinking.wait_for( chrono::seconds(0) ) != future_status::ready ) return;
+        
+        _relinks++;
+        if ( offer( _relinking.get() ) ) _relinksAccepted++;
+    }
+    
+    // Relink the best chromosome with one of the other tracked elites that isn't a clone of it
+    int tracked = _population->GetConfiguration().GetParameters().GetBestTrackCount();
+    vector<GaChromosomePtr> elites( tracked );
+    int numElites = _population->GetBestChromosomes( &elites[0], 0, tracked );
+    
+    vector<int> others;
+    for (int i = 1; i < numElites; i++)
+        if ( *elites[i] != *elites[0] ) others.push_back(i);
+    
+    if ( others.empty() ) return;
+    
+    const Chromosone* best = dynamic_cast<const Chromosone*>( elites[0].GetRawPtr() );
+    const Chromosone* other = dynamic_cast<const Chromosone*>( elites[ others[ GaGlobalRandomIntegerGenerator->Generate( (int)others.size() - 1 ) ] ].GetRawPtr() );
+    
+    // Walk either way round. The relinking thread gets its own copies, so it never touches the population
+    bool towardsBest = GaGlobalRandomBoolGenerator->Generate( 0.5 );
+    Chromosone* initiating = new Chromosone( towardsBest ? *other : *best, false );
+    Chromosone* guiding = new Chromosone( towardsBest ? *best : *other, false );
+    
+    atomic<bool>* cancel = &_cancelWork;
+    
+    _relinking = async( launch::async, [initiating, guiding, cancel]() {
+        Chromosone* result = TTPathRelinking::relink( initiating, guiding, cancel );
+        delete initiating;
+        delete guiding;
+        return result;
+    } );
+}
+
+void TTIncrementalAlgorithm::discardRelinking() {
+    if ( !_relinking.valid() ) return;
+    
+    _cancelWork = true;
+    delete _relinking.get();
+    _cancelWork = false;
+}
+
+void TTIncrementalAlgorithm::searchNeighbourhoods() {
+    
+    GaChromosomePtr best;
+    
+    // With several components, each search gets an even share of the hardware threads to search them on. It's
+    //   only worth splitting them up if that's more than one thread each
+    int threads = max( 1, (int)thread::hardware_concurrency() / (int)_searches.size() );
+    bool components = threads > 1 && Configuration::getInstance().getComponents().size() > 1;
+    
+    for (vector<future<Chromosone*> >::iterator it = _searches.begin(); it != _searches.end(); it++) {
+        
+        if ( (*it).valid() ) {
+            if ( (*it).wait_for( chrono::seconds(0) ) != future_status::ready ) continue;
+            
+            _searchesDone++;
+            if ( offer( (*it).get() ) ) _searchesAccepted++;
+        }
+        
+        if ( best.IsNULL() ) _population->GetBestChromosomes( &best, 0, 1 );
+        
+        // As for relinking, the search gets its own copy
+        Chromosone* start = new Chromosone( dynamic_cast<const Chromosone&>( *best ), false );
+        TTNeighbourhood neighbourhood = (TTNeighbourhood)( _searchRound++ % TT_LNS_NEIGHBOURHOODS );
+        unsigned long seed = GaGlobalRandomIntegerGenerator->Generate();
+        atomic<bool>* cancel = &_cancelWork;
+        
+        *it = async( launch::async, [start, neighbourhood, seed, cancel, components, threads]() {
+            Chromosone* result = components ?
+                TTNeighbourhoodSearch::searchComponents( start, neighbourhood, LNS_ITERATIONS, LNS_MAX_FREED, LNS_MAX_NODES, seed, threads, cancel ) :
+                TTNeighbourhoodSearch::search( start, neighbourhood, LNS_ITERATIONS, LNS_MAX_FREED, LNS_MAX_NODES, seed, cancel );
+            delete start;
+            return result;
+        } );
+    }
+}
+
+void TTIncrementalAlgorithm::discardSearches() {
+    
+    // Cancel them all before waiting for any
+    _cancelWork = true;
+    
+    for (vector<future<Chromosone*> >::iterator it = _searches.begin(); it != _searches.end(); it++)
+        if ( (*it).valid() ) delete (*it).get();
+    
+    _cancelWork = false;
+}
+
+bool TTIncrementalAlgorithm::offer(Chromosone* result) {
+    
+    if (!result) return false;
+    
+    GaChromosomePtr ptr( result );
+    
+    int worst;
+    if ( _population->GetWorsChromosomes( &worst, 0, 1 ) &&
+         TTScoreComparator::compare( *ptr, *_population->GetAt( worst ).GetChromosome() ) > 0 &&
+         !CheckForDuplicates( *_population, *ptr ) ) {
+        _population->Replace( worst, ptr );
+        return true;
+    }
+    
+    return false;
+}
@@ -0,0 +1,187 @@
+//
+//  TTIncremental.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTIncremental__
+#define __Timetabler__TTIncremental__
+
+#include <iostream>
+#include <future>
+#include <atomic>
+#include <vector>
+
+#include "TTChromosone.h"
+#include "TTInitialization.h"
+#include "TTNeighbourhoodSearch.h"
+
+using namespace Algorithm::SimpleAlgorithms;
+
+class TTPathRelinking {
+    
+public:
+    
+    // Walk from initiating towards guiding one move at a time, each time moving whichever student that still
+    //   differs gives the best change in score, ranked tier by tier as TTScoreComparator ranks timetables. Returns
+    //   a new chromosome holding the best timetable strictly between the two by the same rules, or NULL if they're
+    //   less than two moves apart. If cancel is given, gives up and returns NULL as soon as it's set
+    static Chromosone* relink(const Chromosone* initiating, const Chromosone* guiding, const atomic<bool>* cancel = NULL);
+};
+
+// When the GA restarts. It restarts once the best hasn't improved for stagnation generations and the population
+// has collapsed to near-copies of the best, keeping the elites and rebuilding the rest of the population
+class TTRestartParams {
+    
+    // Generations without improvement before the population counts as stagnant
+    int _stagnation;
+    
+    // Average fraction of interviews placed differently from the best, below which the population counts as collapsed
+    double _minDiversity;
+    
+    // Most restarts to make in a run. 0 to never restart
+    int _maxRestarts;
+    
+    // Number of best chromosomes kept through a restart
+    int _elites;
+    
+public:
+    
+    TTRestartParams(int stagnation, double minDiversity, int maxRestarts, int elites) :
+    _stagnation(stagnation),
+    _minDiversity(minDiversity),
+    _maxRestarts(maxRestarts),
+    _elites(elites) {}
+    
+    inline int getStagnation() const { return _stagnation; }
+    inline double getMinDiversity() const { return _minDiversity; }
+    inline int getMaxRestarts() const { return _maxRestarts; }
+    inline int getElites() const { return _elites; }
+};
+
+// Observers that also want to hear about TTIncrementalAlgorithm's restarts should inherit from this as well as GaObserver
+class TTRestartObserver {
+    
+public:
+    
+    virtual ~TTRestartObserver() {}
+    
+    // The population has just been rebuilt for the restart'th time. diversity is what triggered it
+    virtual void PopulationRestarted(int restart, double diversity, const GaAlgorithm& algorithm) = 0;
+};
+
+// The incremental GA, with its population built by TTPopulationInitializer on as many threads as it has workers.
+// Path relinking between pairs of elites runs on a thread of its own while the generations go on, and each
+// timetable it finds is offered to the population at the end of the generation in which it finishes.
+// Large neighbourhood searches from the best timetable run alongside it in the same way, one per search worker,
+// each worker taking the next kind of neighbourhood in turn so that they're never all destroying the same kind.
+// If the configuration splits into several components and each worker's share of the hardware threads is more
+// than one, each search instead covers every component, one thread per component up to that share, and puts them
+// back together: see TTNeighbourhoodSearch::searchComponents.
+// Rather than waiting for the stop criterion with a stagnant population, it restarts as TTRestartParams says.
+// Whenever the algorithm stops, by the user or the stop criterion, the relink and searches still running are
+// cancelled and waited for, so nothing's left reading the configuration once it's stopped.
+class TTIncrementalAlgorithm : public GaIncrementalAlgorithm {
+    
+    GaPopulation* _population;
+    
+    bool _pathRelinking;
+    
+    // The running relink, if any
+    future<Chromosone*> _relinking;
+    
+    // Number of relinks finished, and how many of them made it into the population
+    int _relinks;
+    int _relinksAccepted;
+    
+    // The running large neighbourhood search of each search worker, if any
+    vector<future<Chromosone*> > _searches;
+    
+    // Number of searches started, finished, and how many of them made it into the population
+    int _searchRound;
+    int _searchesDone;
+    int _searchesAccepted;
+    
+    // Set to make the running relink and searches give up
+    atomic<bool> _cancelWork;
+    
+    TTRestartParams _restartParams;
+    
+    int _restarts;
+    
+    // Best timetable so far, and the generation in which it was found or the population was last restarted
+    GaChromosomePtr _best;
+    int _lastProgress;
+    
+    vector<TTRestartObserver*> _restartObservers;
+    
+public:
+    
+    // searchWorkers is the number of large neighbourhood searches to keep running. 0 for none
+    TTIncrementalAlgorithm(GaPopulation* population, const GaMultithreadingAlgorithmParams& parameters, bool pathRelinking, int searchWorkers, const TTRestartParams& restartParams) :
+    GaIncrementalAlgorithm(population, parameters),
+    _population(population),
+    _pathRelinking(pathRelinking),
+    _relinks(0),
+    _relinksAccepted(0),
+    _searches(searchWorkers),
+    _searchRound(0),
+    _searchesDone(0),
+    _searchesAccepted(0),
+    _cancelWork(false),
+    _restartParams(restartParams),
+    _restarts(0),
+    _lastProgress(0) {}
+    
+    virtual ~TTIncrementalAlgorithm() { discardRelinking(); discardSearches(); }
+    
+    inline int getRelinks() const { return _relinks; }
+    inline int getRelinksAccepted() const { return _relinksAccepted; }
+    
+    inline int getSearches() const { return _searchesDone; }
+    inline int getSearchesAccepted() const { return _searchesAccepted; }
+    
+    inline int getRestarts() const { return _restarts; }
+    
+    // Observers that are also TTRestartObservers are told about restarts too
+    virtual void GACALL SubscribeObserver(GaObserver* observer);
+    virtual void GACALL UnsubscribeObserver(GaObserver* observer);
+    
+    // Average fraction of interviews placed differently from the best chromosome, over the rest of the population
+    double diversity() const;
+    
+protected:
+    
+    virtual void GACALL Initialize();
+    
+    virtual void GACALL AfterWorkers();
+    
+    // Stopping, by the user or the stop criterion, also stops the work running in the background
+    virtual bool GACALL OnStop();
+    virtual bool GACALL CheckStopCriteria();
+    
+    // Cancel everything running in the background, wait for it and throw its results away
+    virtual void discardBackground();
+    
+    // Take the result of the running relink if it's finished, then start the next one between two random elites
+    void relinkElites();
+    
+    // Cancel any running relink, wait for it and throw its result away
+    void discardRelinking();
+    
+    // Take the result of each search worker's search if it's finished, then start its next one from the best chromosome
+    void searchNeighbourhoods();
+    
+    // Cancel any running searches, wait for them and throw their results away
+    void discardSearches();
+    
+    // Put result in place of the worst chromosome if it's fitter and not already there. Takes ownership of result
+    bool offer(Chromosone* result);
+    
+    // Restart if the population has stagnated and collapsed, and we've any restarts left
+    void checkStagnation();
+};
+
+#endif /* defined(__Timetabler__TTIncremental__) */
@@ -0,0 +1,103 @@
+//
+//  TTInitialization.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTInitialization.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+// Combine a seed with an index so that neighbouring indices give unrelated generator states (splitmix64's mixing function)
+static unsigned long mixSeed(unsigned long long seed, unsigned long long index) {
+    unsigned long long z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (unsigned long)( z ^ (z >> 31) );
+}
+
+void TTPopulationInitializer::initialize(GaPopulation* population, unsigned long stream) {
+    
+    int size = population->GetConfiguration().GetParameters().GetPopulationSize();
+    
+    vector<GaChromosomePtr> chromosomes(size);
+    build( population, stream, chromosomes );
+    
+    population->InitializePopulation( &chromosomes[0] );
+}
+
+void TTPopulationInitializer::reseed(GaPopulation* population, int keep, unsigned long stream) {
+    
+    vector<int> best( max(keep, 0) );
+    keep = keep > 0 ? population->GetBestChromosomes( &best[0], 0, keep ) : 0;
+    best.resize(keep);
+    
+    // Everyone else goes
+    vector<int> indices;
+    for (int i = 0; i < population->GetCurrentSize(); i++)
+        if ( find( best.begin(), best.end(), i ) == best.end() ) indices.push_back(i);
+    
+    if ( indices.empty() ) return;
+    
+    vector<GaChromosomePtr> chromosomes( indices.size() );
+    build( population, stream, chromosomes );
+    
+    population->ReplaceGroup( &indices[0], &chromosomes[0], (int)indices.size() );
+}
+
+void TTPopulationInitializer::build(GaPopulation* population, unsigned long stream, vector<GaChromosomePtr>& chromosomes) {
+    
+    const Chromosone* prototype = dynamic_cast<const Chromosone*>( &population->GetPrototype() );
+    const TTChromosomeParams* params = dynamic_cast<const TTChromosomeParams*>( &prototype->GetParameters() );
+    int size = (int)chromosomes.size();
+    
+    unsigned long seed = params->getInitSeed() ? params->getInitSeed() : (unsigned long)GaGlobalRandomIntegerGenerator->Generate();
+    seed = mixSeed(seed, stream);
+    
+    // Decide how each chromosome is filled in, in order and on this thread, since this counts off the seeds.
+    //   The timetables kept from the last run are handed out in the same order
+    vector<TTInitMode> modes(size);
+    vector<int> carried(size);
+    int numCarried = 0;
+    
+    for (int i = 0; i < size; i++) {
+        modes[i] = prototype->nextInitMode();
+        if (modes[i] == TT_INIT_CARRIED) carried[i] = numCarried++;
+    }
+    
+    auto make = [&](int i) {
+        GaRandomInteger randomInteger( mixSeed(seed, 2*i) );
+        GaRandomFloat randomFloat( mixSeed(seed, 2*i + 1) );
+        
+        chromosomes[i] = prototype->makeNew( modes[i], &randomInteger, &randomFloat, carried[i] );
+        chromosomes[i]->RefreshFitness();
+    };
+    
+    // The previous solution changes the configuration's count of changed slots, which the fitness depends on,
+    //   so make it before anything is evaluated
+    for (int i = 0; i < size; i++)
+        if (modes[i] == TT_INIT_PREVIOUS) make(i);
+    
+    atomic<int> next(0);
+    
+    auto work = [&]() {
+        for (int i = next++; i < size; i = next++)
+            if (modes[i] != TT_INIT_PREVIOUS) make(i);
+    };
+    
+    int numThreads = min( size, max( 1, (int)thread::hardware_concurrency() ) );
+    
+    vector<thread> threads;
+    for (int t = 1; t < numThreads; t++)
+        threads.push_back( thread(work) );
+    
+    work();
+    
+    for (vector<thread>::iterator it = threads.begin(); it != threads.end(); it++)
+        it->join();
+}
@@ -0,0 +1,42 @@
+//
+//  TTInitialization.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTInitialization__
+#define __Timetabler__TTInitialization__
+
+#include <iostream>
+#include <vector>
+
+#include "TTChromosone.h"
+
+using namespace Algorithm::SimpleAlgorithms;
+
+// Builds populations in parallel. Constructing and evaluating a chromosome doesn't touch any shared state,
+// so the chromosomes are shared out between threads, each with its own random generators. Chromosome i's
+// generators are seeded from the parameters' init seed and i alone, so with a fixed seed the population
+// doesn't depend on the number of threads or how they're scheduled.
+class TTPopulationInitializer {
+    
+public:
+    
+    // Fill the population as GaPopulation::InitializePopulation would, using one thread per hardware thread. The
+    //   algorithms only do this between generations, when their own workers are idle, so it needn't share the
+    //   machine with them. stream gives different populations built from the same seed (the islands, for
+    //   example) different chromosomes
+    static void initialize(GaPopulation* population, unsigned long stream = 0);
+    
+    // Keep the population's keep best chromosomes and replace the rest with new ones, built as for initialize
+    static void reseed(GaPopulation* population, int keep, unsigned long stream);
+    
+private:
+    
+    // Fill chromosomes with new, evaluated chromosomes made from the population's prototype
+    static void build(GaPopulation* population, unsigned long stream, vector<GaChromosomePtr>& chromosomes);
+};
+
+#endif /* defined(__Timetabler__TTInitialization__) */
@@ -0,0 +1,184 @@
+//
+//  TTIslands.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTIslands.h"
+#include "TTInitialization.h"
+
+TTIslandAlgorithm::TTIslandAlgorithm(GaPopulation* population, const TTIslandParams& parameters) :
+    GaMultithreadingAlgorithm(parameters),
+    _parameters(parameters),
+    _population(population)
+{
+}
+
+TTIslandAlgorithm::~TTIslandAlgorithm() {
+    clearIslands();
+}
+
+void TTIslandAlgorithm::clearIslands() {
+
+    GaPopulationConfiguration* configuration = const_cast<GaPopulationConfiguration*>( &_population->GetConfiguration() );
+
+    for (int i = 0; i < (int)_islands.size(); i++) {
+        // island 0's population isn't ours
+        if (i > 0) {
+            configuration->UnbindPopulation( _islands[i]->population );
+            delete _islands[i]->population;
+        }
+        delete _islands[i];
+    }
+    _islands.clear();
+}
+
+void TTIslandAlgorithm::SetAlgorithmParameters(const GaAlgorithmParams& parameters) {
+
+    // change parameters of multithreading
+    GaMultithreadingAlgorithm::SetAlgorithmParameters( parameters );
+
+    // save parameters. A change in the number of islands takes effect on the next Initialize
+    _parameters = (const TTIslandParams&) parameters;
+}
+
+// Make one island per worker, all with the same configuration as the given population
+void TTIslandAlgorithm::Initialize() {
+
+    clearIslands();
+
+    GaChromosome* prototype = const_cast<GaChromosome*>( &_population->GetPrototype() );
+    GaPopulationConfiguration* configuration = const_cast<GaPopulationConfiguration*>( &_population->GetConfiguration() );
+
+    for (int i = 0; i < _parameters.GetNumberOfWorkers(); i++) {
+
+        GaPopulation* population = i ? new GaPopulation( prototype, configuration ) : _population;
+        TTPopulationInitializer::initialize( population, i );
+
+        _islands.push_back( new TTIsland(population) );
+    }
+
+    _bestChromosome = NULL;
+}
+
+void TTIslandAlgorithm::generation(TTIsland& island) {
+
+    GaPopulation* population = island.population;
+    const GaPopulationConfiguration& configuration = population->GetConfiguration();
+    GaSelectionResultSet* selection = &island.buffer->GetSelectionResultSet();
+
+    // update statistics of population
+    population->NextGeneration();
+
+    // change the buffers' sizes if needed
+    selection->SelectedGroup().SetMaxSize( configuration.Selection().GetParameters().GetSelectionSize() );
+    island.buffer->SetNumberOfOffsprings( configuration.Coupling().GetParameters().GetNumberOfOffsprings() );
+
+    // selection
+    configuration.Selection().GetOperation()( *population, configuration.Selection().GetParameters(), *selection );
+
+    // coupling, all on this thread
+    configuration.Coupling().GetOperation()( *population, *island.buffer, configuration.Coupling().GetParameters(), 0, 1 );
+
+    // replacement
+    configuration.Replacement().GetOperation()( *population, configuration.Replacement().GetParameters(), *island.buffer );
+
+    // update population
+    population->EndOfGeneration();
+
+    island.generations++;
+}
+
+void TTIslandAlgorithm::emigrate(int islandId) {
+
+    int n = (int)_islands.size();
+    if (n < 2) return;
+
+    GaChromosomePtr best;
+    _islands[islandId]->population->GetBestChromosomes( &best, 0, 1 );
+    const Chromosone& migrant = dynamic_cast<const Chromosone&>( *best );
+
+    // Work out who to send to
+    vector<int> destinations;
+    if ( _parameters.getTopology() == TT_MIGRATE_RING )
+        destinations.push_back( (islandId + 1) % n );
+    else if (islandId == 0) {
+        for (int i = 1; i < n; i++) destinations.push_back(i);
+    }
+    else destinations.push_back(0);
+
+    // Each island gets its own copy, and frees any migrant it hadn't got round to taking
+    for (vector<int>::iterator it = destinations.begin(); it != destinations.end(); it++)
+        delete _islands[*it]->mailbox.exchange( new Chromosone( migrant, false ) );
+}
+
+void TTIslandAlgorithm::immigrate(TTIsland& island) {
+
+    Chromosone* migrant = island.mailbox.exchange(NULL);
+    if (!migrant) return;
+
+    // The population takes ownership
+    GaChromosomePtr ptr( migrant );
+
+    int worst;
+    if ( island.population->GetWorsChromosomes( &worst, 0, 1 ) &&
+         TTScoreComparator::compare( *ptr, *island.population->GetAt( worst ).GetChromosome() ) > 0 )
+        island.population->Replace( worst, ptr );
+}
+
+// Evolve this worker's island for a whole epoch
+void TTIslandAlgorithm::WorkStep(int workerId) {
+
+    if ( workerId >= (int)_islands.size() ) return;
+
+    TTIsland& island = *_islands[workerId];
+
+    for (int i = 0; i < _parameters.getEpochLength() && _state == GAS_RUNNING; i++) {
+
+        immigrate(island);
+
+        generation(island);
+
+        if ( island.generations % _parameters.getMigrationInterval() == 0 )
+            emigrate(workerId);
+    }
+}
+
+void TTIslandAlgorithm::AfterWorkers() {
+
+    // Find the best chromosome on any island
+    GaChromosomePtr best;
+    for (int i = 0; i < (int)_islands.size(); i++) {
+        GaChromosomePtr islandBest;
+        _islands[i]->population->GetBestChromosomes( &islandBest, 0, 1 );
+
+        if ( best.IsNULL() || TTScoreComparator::compare( *islandBest, *best ) > 0 )
+            best = islandBest;
+    }
+
+    // Make sure island 0 has it, so the GUI and stop criteria see it
+    GaChromosomePtr home;
+    _population->GetBestChromosomes( &home, 0, 1 );
+
+    int worst;
+    if ( TTScoreComparator::compare( *best, *home ) > 0 && _population->GetWorsChromosomes( &worst, 0, 1 ) )
+        _population->Replace( worst, best->MakeCopy(false) );
+
+    // rais "update statistics" event
+    _observers.StatisticUpdate( _population->GetStatistics(), *this );
+
+    // get best chromosome
+    int i;
+    _population->GetBestChromosomes( &i, 0, 1 );
+    GaChromosomePtr f = _population->GetAt( i ).GetChromosome();
+
+    // best chromosome changed?
+    if( _bestChromosome.IsNULL() || *f != *_bestChromosome )
+    {
+        // raise "new best chromosome found" event
+        _bestChromosome = f;
+        _observers.NewBestChromosome( *_bestChromosome, *this );
+    }
+}
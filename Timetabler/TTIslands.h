@@ -0,0 +1,129 @@
+//
+//  TTIslands.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTIslands__
+#define __Timetabler__TTIslands__
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+
+#include "TTChromosone.h"
+#include "GLSource/MultithreadingAlgorithm.h"
+
+using namespace Algorithm;
+
+// Which islands send their best chromosome to which
+enum TTMigrationTopology {
+    TT_MIGRATE_RING,    // island i sends to island i+1
+    TT_MIGRATE_STAR     // every island sends to island 0, which sends to all the others
+};
+
+// Parameters for the island model. There is one island per worker thread.
+class TTIslandParams : public GaMultithreadingAlgorithmParams {
+
+    // Number of generations each island runs between synchronisations with the control thread
+    int _epochLength;
+
+    // Each island sends its best chromosome to its neighbour(s) every migrationInterval generations
+    int _migrationInterval;
+
+    TTMigrationTopology _topology;
+
+public:
+
+    TTIslandParams(int numberOfIslands, int epochLength, int migrationInterval, TTMigrationTopology topology) :
+    GaMultithreadingAlgorithmParams(numberOfIslands),
+    _epochLength(epochLength),
+    _migrationInterval(migrationInterval),
+    _topology(topology) {}
+
+    virtual GaParameters* GACALL Clone() const { return new TTIslandParams( *this ); }
+
+    inline int getEpochLength() const { return _epochLength; }
+    inline int getMigrationInterval() const { return _migrationInterval; }
+    inline TTMigrationTopology getTopology() const { return _topology; }
+};
+
+// One island: a population evolved by the incremental algorithm's steps on a single thread
+struct TTIsland {
+
+    GaPopulation* population;
+    GaCouplingResultSet* buffer;
+
+    // Lock-free mailbox holding the latest migrant sent to this island, or NULL. A migrant
+    //   that arrives before the last one was taken replaces it
+    atomic<Chromosone*> mailbox;
+
+    int generations;
+
+    TTIsland(GaPopulation* p) : population(p), mailbox(NULL), generations(0) {
+        buffer = new GaCouplingResultSet( 0, new GaSelectionResultSet( 0, population ) );
+    }
+
+    ~TTIsland() {
+        delete mailbox.exchange(NULL);
+        delete &buffer->GetSelectionResultSet();
+        delete buffer;
+    }
+};
+
+// Island model GA. Each worker evolves its own island for a whole epoch of generations without
+// synchronising with the others; islands only interact through their mailboxes. Between epochs
+// the control thread copies the overall best into island 0, which is the population reported
+// to the GUI, the observers and the stop criteria.
+class TTIslandAlgorithm : public GaMultithreadingAlgorithm {
+
+    TTIslandParams _parameters;
+
+    // Island 0's population, which belongs to the caller. The other islands' are made to match it
+    GaPopulation* _population;
+
+    vector<TTIsland*> _islands;
+
+    GaChromosomePtr _bestChromosome;
+
+public:
+
+    TTIslandAlgorithm(GaPopulation* population, const TTIslandParams& parameters);
+
+    virtual ~TTIslandAlgorithm();
+
+    virtual const GaAlgorithmParams& GACALL GetAlgorithmParameters() const { return _parameters; }
+
+    virtual void GACALL SetAlgorithmParameters(const GaAlgorithmParams& parameters);
+
+    virtual const GaPopulation& GACALL GetPopulation(int index) const {
+        return index > 0 && index < (int)_islands.size() ? *_islands[index]->population : *_population;
+    }
+
+    virtual const GaStatistics& GACALL GetAlgorithmStatistics() const { return _population->GetStatistics(); }
+
+    inline int getNumberOfIslands() const { return (int)_islands.size(); }
+
+protected:
+
+    virtual void GACALL Initialize();
+
+    virtual void GACALL WorkStep(int workerId);
+
+    virtual void GACALL AfterWorkers();
+
+    // Run one generation of the incremental algorithm on the island
+    void generation(TTIsland& island);
+
+    // Post a copy of the island's best chromosome to its neighbours' mailboxes
+    void emigrate(int islandId);
+
+    // Take any migrant waiting in the island's mailbox in place of its worst chromosome
+    void immigrate(TTIsland& island);
+
+    void clearIslands();
+};
+
+#endif /* defined(__Timetabler__TTIslands__) */
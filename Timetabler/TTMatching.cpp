@@ -0,0 +1,99 @@
+//
+//  TTMatching.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTMatching.h"
+
+#include <queue>
+#include <algorithm>
+#include <climits>
+
+TTHopcroftKarp::TTHopcroftKarp(int numLeft, int numRight) :
+    _numLeft(numLeft),
+    _numRight(numRight),
+    _adjacency(numLeft),
+    _matchLeft(numLeft, -1),
+    _matchRight(numRight, -1),
+    _distance(numLeft)
+{
+}
+
+void TTHopcroftKarp::removeEdge(int left, int right) {
+    
+    vector<int>& edges = _adjacency[left];
+    edges.erase( remove( edges.begin(), edges.end(), right ), edges.end() );
+    
+    if (_matchLeft[left] == right) {
+        _matchLeft[left] = -1;
+        _matchRight[right] = -1;
+    }
+}
+
+bool TTHopcroftKarp::bfs() {
+    
+    queue<int> q;
+    
+    for (int u = 0; u < _numLeft; u++) {
+        if (_matchLeft[u] < 0) {
+            _distance[u] = 0;
+            q.push(u);
+        }
+        else _distance[u] = INT_MAX;
+    }
+    
+    bool found = false;
+    
+    while ( !q.empty() ) {
+        int u = q.front();
+        q.pop();
+        
+        for (vector<int>::const_iterator it = _adjacency[u].begin(); it != _adjacency[u].end(); it++) {
+            int w = _matchRight[*it];
+            
+            // A free right vertex ends an augmenting path
+            if (w < 0) found = true;
+            else if (_distance[w] == INT_MAX) {
+                _distance[w] = _distance[u] + 1;
+                q.push(w);
+            }
+        }
+    }
+    
+    return found;
+}
+
+bool TTHopcroftKarp::dfs(int u) {
+    
+    for (vector<int>::const_iterator it = _adjacency[u].begin(); it != _adjacency[u].end(); it++) {
+        int w = _matchRight[*it];
+        
+        if ( w < 0 || (_distance[w] == _distance[u] + 1 && dfs(w)) ) {
+            _matchLeft[u] = *it;
+            _matchRight[*it] = u;
+            return true;
+        }
+    }
+    
+    // Dead end: don't come back here this phase
+    _distance[u] = INT_MAX;
+    return false;
+}
+
+int TTHopcroftKarp::solve() {
+    
+    // Each phase augments along a maximal set of shortest, vertex-disjoint augmenting paths
+    while ( bfs() ) {
+        for (int u = 0; u < _numLeft; u++)
+            if (_matchLeft[u] < 0) dfs(u);
+    }
+    
+    int size = 0;
+    for (int u = 0; u < _numLeft; u++)
+        if (_matchLeft[u] >= 0) size++;
+    
+    return size;
+}
@@ -0,0 +1,55 @@
+//
+//  TTMatching.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTMatching__
+#define __Timetabler__TTMatching__
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// Maximum bipartite matching by the Hopcroft-Karp algorithm, in O(E sqrt(V)).
+// solve() can be called again after edges are removed or pairs unmatched: it grows the
+// existing matching rather than starting from scratch.
+class TTHopcroftKarp {
+    
+    int _numLeft;
+    int _numRight;
+    
+    vector<vector<int> > _adjacency;    // right vertices joined to each left vertex, tried in this order
+    
+    vector<int> _matchLeft;             // right vertex matched to each left vertex, or -1
+    vector<int> _matchRight;            // left vertex matched to each right vertex, or -1
+    
+    vector<int> _distance;              // layer of each left vertex in the current phase
+    
+    // Build the layers from the free left vertices. Returns whether any augmenting path exists
+    bool bfs();
+    
+    // Look for an augmenting path from left vertex u along the layers
+    bool dfs(int u);
+    
+public:
+    
+    TTHopcroftKarp(int numLeft, int numRight);
+    
+    inline void addEdge(int left, int right) { _adjacency[left].push_back(right); }
+    
+    // Remove an edge, unmatching its ends if they were matched along it
+    void removeEdge(int left, int right);
+    
+    inline const vector<int>& getEdges(int left) const { return _adjacency[left]; }
+    
+    // Grow the matching to a maximum one. Returns its size
+    int solve();
+    
+    inline int getMatch(int left) const { return _matchLeft[left]; }
+};
+
+#endif /* defined(__Timetabler__TTMatching__) */
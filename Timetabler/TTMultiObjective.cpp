@@ -0,0 +1,300 @@
+//
+//  TTMultiObjective.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTMultiObjective.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "GLsource/GlobalRandomGenerator.h"
+
+bool TTParetoSort::dominates(const TTObjectiveVector& a, const TTObjectiveVector& b) {
+
+    bool better = false;
+
+    for (int i = 0; i < TT_NUM_OBJECTIVES; i++) {
+        if (a[i] < b[i]) return false;
+        if (a[i] > b[i]) better = true;
+    }
+
+    return better;
+}
+
+void TTParetoSort::sort(const vector<TTObjectiveVector>& points, vector<vector<int> >& fronts) {
+
+    fronts.clear();
+
+    // Best first, lexicographically: nothing can be dominated by a point after it
+    vector<int> order( points.size() );
+    for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+
+    std::sort( order.begin(), order.end(), [&points](int a, int b) {
+        for (int i = 0; i < TT_NUM_OBJECTIVES; i++)
+            if (points[a][i] != points[b][i]) return points[a][i] > points[b][i];
+        return false;
+    } );
+
+    for (vector<int>::iterator p = order.begin(); p != order.end(); p++) {
+
+        // The first front with nothing in it that dominates p. The most recently added points are the most
+        //   like p, so they're the likeliest to dominate it and are checked first
+        int k = 0;
+        for ( ; k < (int)fronts.size(); k++) {
+            bool dominated = false;
+
+            for (vector<int>::reverse_iterator q = fronts[k].rbegin(); q != fronts[k].rend() && !dominated; q++)
+                dominated = dominates( points[*q], points[*p] );
+
+            if (!dominated) break;
+        }
+
+        if (k == (int)fronts.size()) fronts.push_back( vector<int>() );
+        fronts[k].push_back(*p);
+    }
+}
+
+void TTParetoSort::crowding(const vector<TTObjectiveVector>& points, const vector<int>& front, vector<double>& distance) {
+
+    int size = (int)front.size();
+
+    distance.assign( size, 0 );
+    if (size <= 2) {
+        distance.assign( size, numeric_limits<double>::infinity() );
+        return;
+    }
+
+    vector<int> order(size);
+
+    for (int m = 0; m < TT_NUM_OBJECTIVES; m++) {
+
+        for (int i = 0; i < size; i++) order[i] = i;
+        std::sort( order.begin(), order.end(), [&points, &front, m](int a, int b) { return points[ front[a] ][m] < points[ front[b] ][m]; } );
+
+        double low = points[ front[ order.front() ] ][m], high = points[ front[ order.back() ] ][m];
+
+        distance[ order.front() ] = distance[ order.back() ] = numeric_limits<double>::infinity();
+
+        // Every point scores the same on this one
+        if (high <= low) continue;
+
+        for (int i = 1; i < size - 1; i++)
+            distance[ order[i] ] += ( points[ front[ order[i + 1] ] ][m] - points[ front[ order[i - 1] ] ][m] ) / (high - low);
+    }
+}
+
+void TTCrowdingReplacement::crowdFront(const vector<TTObjectiveVector>& points, const vector<TTScore>& scores, const vector<int>& front, vector<double>& crowding) {
+
+    vector<double> distance;
+    TTParetoSort::crowding( points, front, distance );
+
+    int best = 0;
+
+    for (int i = 0; i < (int)front.size(); i++) {
+        crowding[ front[i] ] = distance[i];
+
+        if (i == 0 || TTScoreComparator::compare( scores[ front[i] ], scores[best] ) > 0) best = front[i];
+    }
+
+    if ( !front.empty() ) crowding[best] = numeric_limits<double>::infinity();
+}
+
+void TTCrowdingReplacement::rankPoints(const vector<TTObjectiveVector>& points, const vector<TTScore>& scores, vector<vector<int> >& fronts, vector<int>& rank, vector<double>& crowding) {
+
+    TTParetoSort::sort( points, fronts );
+
+    rank.resize( points.size() );
+    crowding.resize( points.size() );
+
+    for (int f = 0; f < (int)fronts.size(); f++) {
+        for (vector<int>::iterator it = fronts[f].begin(); it != fronts[f].end(); it++)
+            rank[*it] = f;
+
+        crowdFront( points, scores, fronts[f], crowding );
+    }
+}
+
+TTObjectiveVector TTCrowdingReplacement::objectives(const TTScore& score) {
+
+    TTObjectiveVector objectives;
+    for (int i = 0; i < TT_NUM_OBJECTIVES; i++) objectives[i] = (float)score.units[i] / SCORE_UNITS;
+
+    return objectives;
+}
+
+void TTCrowdingReplacement::rank(const GaPopulation& population) const {
+
+    lock_guard<mutex> lock(_lock);
+
+    int size = population.GetCurrentSize();
+    bool changed = (int)_members.size() != size;
+
+    _members.resize(size);
+
+    for (int i = 0; i < size; i++) {
+        GaChromosomePtr chromosome = population.GetAt(i).GetChromosome();
+        if ( _members[i].chromosome.GetRawPtr() == chromosome.GetRawPtr() ) continue;
+
+        _members[i].chromosome = chromosome;
+        _members[i].score = TTFitness::score( dynamic_cast<const Chromosone*>( chromosome.GetRawPtr() ) );
+        _members[i].objectives = objectives( _members[i].score );
+        changed = true;
+    }
+
+    if (!changed) return;
+
+    vector<TTObjectiveVector> points(size);
+    vector<TTScore> scores(size);
+    for (int i = 0; i < size; i++) {
+        points[i] = _members[i].objectives;
+        scores[i] = _members[i].score;
+    }
+
+    vector<vector<int> > fronts;
+    vector<int> ranks;
+    vector<double> crowding;
+    rankPoints( points, scores, fronts, ranks, crowding );
+
+    for (int i = 0; i < size; i++) {
+        _members[i].rank = ranks[i];
+        _members[i].crowding = crowding[i];
+    }
+}
+
+void TTCrowdingReplacement::operator()(GaPopulation& population, const GaReplacementParams& parameters, const GaCouplingResultSet& newChromosomes) const {
+
+    rank(population);
+
+    lock_guard<mutex> lock(_lock);
+
+    int size = (int)_members.size();
+
+    // The children that were made (the coupling leaves out any it didn't get round to)
+    vector<GaChromosomePtr> children;
+    for (int i = 0; i < newChromosomes.GetNumberOfOffsprings() && (int)children.size() < parameters.GetReplacementSize(); i++) {
+        GaChromosomePtr child;
+        int parent;
+        newChromosomes.GetOffspringAt( i, child, parent );
+
+        if ( !child.IsNULL() ) children.push_back(child);
+    }
+
+    if ( children.empty() ) return;
+
+    // The population then the children
+    vector<TTObjectiveVector> points( size + children.size() );
+    vector<TTScore> scores( size + children.size() );
+    for (int i = 0; i < size; i++) {
+        points[i] = _members[i].objectives;
+        scores[i] = _members[i].score;
+    }
+    for (int i = 0; i < (int)children.size(); i++) {
+        scores[size + i] = TTFitness::score( dynamic_cast<const Chromosone*>( children[i].GetRawPtr() ) );
+        points[size + i] = objectives( scores[size + i] );
+    }
+
+    vector<vector<int> > fronts;
+    vector<int> ranks;
+    vector<double> crowding;
+    rankPoints( points, scores, fronts, ranks, crowding );
+
+    // Drop as many as there are children: whole fronts from the back while they fit, then the most crowded of
+    //   the next one, one at a time since each one dropped changes its neighbours' crowding
+    vector<bool> dropped( points.size(), false );
+    int wanted = (int)children.size();
+
+    for (int f = (int)fronts.size() - 1; f >= 0 && wanted > 0; f--) {
+        vector<int>& front = fronts[f];
+
+        if ((int)front.size() <= wanted) {
+            for (vector<int>::iterator it = front.begin(); it != front.end(); it++) dropped[*it] = true;
+            wanted -= front.size();
+            continue;
+        }
+
+        for ( ; wanted > 0; wanted--) {
+            vector<int>::iterator worst = front.begin();
+            for (vector<int>::iterator it = front.begin(); it != front.end(); it++)
+                if ( crowding[*it] < crowding[*worst] ) worst = it;
+
+            dropped[*worst] = true;
+            front.erase(worst);
+            crowdFront( points, scores, front, crowding );
+        }
+    }
+
+    // The surviving children go in the places of the dropped members of the population. There are as many of each
+    vector<int> places;
+    vector<int> survivors;
+    for (int i = 0; i < size; i++) if ( dropped[i] ) places.push_back(i);
+    for (int i = size; i < (int)points.size(); i++) if ( !dropped[i] ) survivors.push_back(i);
+
+    vector<GaChromosomePtr> replacements;
+    for (vector<int>::iterator it = survivors.begin(); it != survivors.end(); it++) replacements.push_back( children[*it - size] );
+
+    if ( !places.empty() ) population.ReplaceGroup( &places[0], &replacements[0], (int)places.size() );
+
+    for (int i = 0; i < (int)places.size(); i++) {
+        _members[ places[i] ].chromosome = replacements[i];
+        _members[ places[i] ].score = scores[ survivors[i] ];
+        _members[ places[i] ].objectives = points[ survivors[i] ];
+    }
+
+    // Dropping from the back leaves everyone else's front as it was
+    for (int i = 0; i < size; i++) {
+        int point = dropped[i] ? survivors[ find( places.begin(), places.end(), i ) - places.begin() ] : i;
+        _members[i].rank = ranks[point];
+        _members[i].crowding = crowding[point];
+    }
+}
+
+bool TTCrowdingReplacement::crowdedBetter(int a, int b) const {
+
+    if (_members[a].rank != _members[b].rank) return _members[a].rank < _members[b].rank;
+
+    return _members[a].crowding > _members[b].crowding;
+}
+
+void TTCrowdingReplacement::getFront(vector<GaChromosomePtr>& front, vector<TTObjectiveVector>& objectives) const {
+
+    lock_guard<mutex> lock(_lock);
+
+    front.clear();
+    objectives.clear();
+
+    for (vector<Member>::const_iterator it = _members.begin(); it != _members.end(); it++) {
+        if ( (*it).rank != 0 ) continue;
+
+        front.push_back( (*it).chromosome );
+        objectives.push_back( (*it).objectives );
+    }
+}
+
+void TTCrowdedTournament::operator()(const GaPopulation& population, const GaSelectionParams& parameters, GaSelectionResultSet& result) const {
+
+    result.SelectedGroup().Clear();
+
+    int size = population.GetCurrentSize();
+    if (size < 2) return;
+
+    _ranking->rank(population);
+
+    // Each parent is picked once at most, so there must be someone left for the last tournament
+    int number = min( parameters.GetSelectionSize(), size - 1 );
+
+    for (int i = 0; i < number; i++) {
+        int a, b;
+
+        do a = GaGlobalRandomIntegerGenerator->Generate( size - 1 );
+        while ( result.SelectedGroup().GetRanking(a) >= 0 );
+
+        do b = GaGlobalRandomIntegerGenerator->Generate( size - 1 );
+        while ( b == a || result.SelectedGroup().GetRanking(b) >= 0 );
+
+        result.SelectedGroup().Add( _ranking->crowdedBetter(b, a) ? b : a );
+    }
+}
@@ -0,0 +1,109 @@
+//
+//  TTMultiObjective.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTMultiObjective__
+#define __Timetabler__TTMultiObjective__
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+
+#include "TTChromosone.h"
+
+using namespace Population;
+
+// Non-dominated sorting and crowding distance over TTFitness::objectives, for NSGA-II
+class TTParetoSort {
+
+public:
+
+    // Is a at least as good as b in every objective, and better in at least one?
+    static bool dominates(const TTObjectiveVector& a, const TTObjectiveVector& b);
+
+    // Sort points into fronts of mutually non-dominated points, the non-dominated ones first. This is efficient
+    //   non-dominated sort with sequential search: in lexicographic order, each point can only be dominated by
+    //   points before it, so it goes in the first front that none of them dominates it in. Usually far fewer
+    //   comparisons than the N^2 of fast non-dominated sort
+    static void sort(const vector<TTObjectiveVector>& points, vector<vector<int> >& fronts);
+
+    // Crowding distance of each point in front (indices into points), in the same order: the sum over the objectives
+    //   of the gap between its neighbours either side, relative to the front's range. Infinite at each end
+    static void crowding(const vector<TTObjectiveVector>& points, const vector<int>& front, vector<double>& distance);
+};
+
+// NSGA-II's environmental selection, as a steady-state replacement: the population and the generation's children
+// are sorted into fronts together, and the children take the places of the worst of the lot, the last fronts first
+// and the most crowded of a front first. The best timetable by TTScoreComparator is never dropped (it's always in
+// the first front), so the GA's best only ever gets better as usual.
+// It also keeps the population's ranks and crowding distances up to date for TTCrowdedTournament, and the Pareto
+// front for anyone to look at, rescoring any chromosome that something else (a restart, say) has put in.
+class TTCrowdingReplacement : public GaReplacementOperation {
+
+    // What's known about each chromosome in the population, by index
+    struct Member {
+        GaChromosomePtr chromosome;     // holds on to it, so the same address can't turn up again as a different chromosome
+        TTScore score;                  // exact, for picking out the best by TTScoreComparator
+        TTObjectiveVector objectives;
+        int rank;                       // its front, 0 for non-dominated
+        double crowding;
+    };
+
+    mutable vector<Member> _members;
+
+    // Guards _members against getFront being called from another thread
+    mutable mutex _lock;
+
+public:
+
+    virtual void GACALL operator ()(GaPopulation& population, const GaReplacementParams& parameters, const GaCouplingResultSet& newChromosomes) const;
+
+    virtual GaParameters* GACALL MakeParameters() const { return new GaReplacementParams(); }
+
+    virtual bool GACALL CheckParameters(const GaParameters& parameters) const { return ( (const GaReplacementParams&) parameters ).GetReplacementSize() > 0; }
+
+    // Bring the ranks and crowding distances up to date with population, if anything's changed
+    void rank(const GaPopulation& population) const;
+
+    // Is the chromosome at index a better than the one at b: a better front or, in the same front, less crowded?
+    //   Only valid after rank
+    bool crowdedBetter(int a, int b) const;
+
+    // The current Pareto front: the non-dominated timetables and their objectives
+    void getFront(vector<GaChromosomePtr>& front, vector<TTObjectiveVector>& objectives) const;
+
+private:
+
+    // Rank and crowd points into rank and crowding, given that points can be split into fronts. Returns the fronts.
+    //   scores are the points' exact scores, and the best of them by TTScoreComparator gets infinite crowding distance
+    static void rankPoints(const vector<TTObjectiveVector>& points, const vector<TTScore>& scores, vector<vector<int> >& fronts, vector<int>& rank, vector<double>& crowding);
+
+    // Set the crowding distances of front's points, the best by TTScoreComparator being infinite
+    static void crowdFront(const vector<TTObjectiveVector>& points, const vector<TTScore>& scores, const vector<int>& front, vector<double>& crowding);
+
+    // The objectives of a timetable with the given score, as TTFitness::objectives
+    static TTObjectiveVector objectives(const TTScore& score);
+};
+
+// NSGA-II's mating selection: binary tournaments by crowded comparison, see TTCrowdingReplacement::crowdedBetter
+class TTCrowdedTournament : public GaSelectionOperation {
+
+    // Where the ranks come from. Not owned
+    const TTCrowdingReplacement* _ranking;
+
+public:
+
+    TTCrowdedTournament(const TTCrowdingReplacement* ranking) : _ranking(ranking) {}
+
+    virtual void GACALL operator ()(const GaPopulation& population, const GaSelectionParams& parameters, GaSelectionResultSet& result) const;
+
+    virtual GaParameters* GACALL MakeParameters() const { return new GaSelectionParams(); }
+
+    virtual bool GACALL CheckParameters(const GaParameters& parameters) const { return ( (const GaSelectionParams&) parameters ).GetSelectionSize() > 0; }
+};
+
+#endif /* defined(__Timetabler__TTMultiObjective__) */
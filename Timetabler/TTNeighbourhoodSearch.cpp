@@ -0,0 +1,204 @@
+//
+//  TTNeighbourhoodSearch.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTNeighbourhoodSearch.h"
+
+// Number of tutors whose rows a subject neighbourhood's students can go in
+#define SUBJECT_TUTORS 3
+
+// Fisher-Yates shuffle with our own generator
+template <class T> static void shuffle(vector<T>& v, GaRandomInteger* random) {
+    for (int i = (int)v.size() - 1; i > 0; i--)
+        swap( v[i], v[ random->Generate(i) ] );
+}
+
+Chromosone* TTNeighbourhoodSearch::search(const Chromosone* start, TTNeighbourhood neighbourhood, int iterations, int maxFreed, long long maxNodes, unsigned long seed, const atomic<bool>* cancel, int component) {
+
+    GaRandomInteger random(seed);
+
+    Chromosone* current = new Chromosone( *start, false );
+    bool improved = false;
+
+    vector<Student*> freed;
+    vector<int> region;
+
+    for (int i = 0; i < iterations && !( cancel && *cancel ); i++) {
+
+        destroy( current, neighbourhood, maxFreed, &random, freed, region, component );
+        if ( freed.empty() ) continue;
+
+        TTBranchAndBound repair( current, freed, region );
+
+        if ( repair.solve(maxNodes, NULL, cancel) ) {
+            repair.apply(current);
+            improved = true;
+        }
+    }
+
+    if (!improved) {
+        delete current;
+        return NULL;
+    }
+
+    return current;
+}
+
+Chromosone* TTNeighbourhoodSearch::searchComponents(const Chromosone* start, TTNeighbourhood neighbourhood, int iterations, int maxFreed, long long maxNodes, unsigned long seed, int threads, const atomic<bool>* cancel) {
+
+    Configuration& config = Configuration::getInstance();
+    const vector<SubjectComponent>& components = config.getComponents();
+    int numComponents = (int)components.size();
+    int numStudents = max( 1, (int)config.getStudentVector().size() );
+
+    // Each thread takes the next component nobody's searched yet, until there are none left. The iterations are
+    //   shared out by the components' sizes, so that all together they're no more work than a search of the whole
+    vector<Chromosone*> results( numComponents, (Chromosone*)NULL );
+    atomic<int> next(0);
+
+    auto work = [&]() {
+        for (int c = next++; c < numComponents; c = next++) {
+            int share = max( 1, iterations * (int)components[c].students.size() / numStudents );
+            results[c] = search( start, neighbourhood, share, maxFreed, maxNodes, seed + c, cancel, c );
+        }
+    };
+
+    vector<future<void> > workers;
+    for (int i = 0; i < threads && i < numComponents; i++)
+        workers.push_back( async( launch::async, work ) );
+    for (vector<future<void> >::iterator it = workers.begin(); it != workers.end(); it++)
+        (*it).get();
+
+    // Copy each improved component's rows across. Only the students freed from them have moved, and only within them
+    Chromosone* merged = new Chromosone( *start, false );
+    Chromosone* best = NULL;
+
+    for (int c = 0; c < numComponents; c++) {
+        if ( !results[c] ) continue;
+
+        const vector<list<Student*> >& slots = results[c]->GetSlots();
+        for (vector<int>::const_iterator t = components[c].tutors.begin(); t != components[c].tutors.end(); t++) {
+            for (int slot = *t * SLOTS_IN_DAY; slot < (*t + 1) * SLOTS_IN_DAY; slot++) {
+                for (list<Student*>::const_iterator it = slots[slot].begin(); it != slots[slot].end(); it++) {
+                    int from = merged->getSlot(*it);
+                    if (from != slot) merged->applyMove( TTMove( *it, from, slot ) );
+                }
+            }
+        }
+
+        if ( !best || TTScoreComparator::compare( *results[c], *best ) > 0 ) best = results[c];
+    }
+
+    if (!best) {
+        delete merged;
+        return NULL;
+    }
+
+    merged->RefreshFitness();
+
+    Chromosone* chosen = TTScoreComparator::compare( *merged, *best ) >= 0 ? merged : best;
+    if (chosen != merged) delete merged;
+    for (vector<Chromosone*>::iterator it = results.begin(); it != results.end(); it++)
+        if (*it != chosen) delete *it;
+
+    return chosen;
+}
+
+bool TTNeighbourhoodSearch::freeSlot(const Chromosone* chromo, int slot, int maxFreed, vector<Student*>& freed, vector<int>& region) {
+
+    const list<Student*>& occupants = chromo->GetSlots()[slot];
+
+    // Already freed?
+    if ( !occupants.empty() && find( freed.begin(), freed.end(), occupants.front() ) != freed.end() ) return true;
+
+    if ( (int)freed.size() + (int)occupants.size() > maxFreed ) return false;
+
+    freed.insert( freed.end(), occupants.begin(), occupants.end() );
+    region.push_back(slot);
+
+    return true;
+}
+
+void TTNeighbourhoodSearch::destroy(const Chromosone* chromo, TTNeighbourhood neighbourhood, int maxFreed, GaRandomInteger* random, vector<Student*>& freed, vector<int>& region, int component) {
+
+    Configuration& config = Configuration::getInstance();
+    int numTutors = config.numTutors();
+
+    freed.clear();
+    region.clear();
+
+    vector<int> tutors;
+    if (component >= 0) tutors = config.getComponents()[component].tutors;
+    else {
+        tutors.resize( numTutors );
+        for (int t = 0; t < numTutors; t++) tutors[t] = t;
+    }
+    shuffle( tutors, random );
+
+    switch (neighbourhood) {
+
+        case TT_LNS_SESSION: {
+            // As many tutors' blocks of one session as there's room for
+            int session = random->Generate(2);
+            int first = session * SLOTS_IN_DAY / 3, last = (session + 1) * SLOTS_IN_DAY / 3;
+
+            for (vector<int>::iterator t = tutors.begin(); t != tutors.end() && (int)freed.size() < maxFreed; t++)
+                for (int time = first; time < last; time++)
+                    freeSlot( chromo, *t * SLOTS_IN_DAY + time, maxFreed, freed, region );
+            break;
+        }
+
+        case TT_LNS_SUBJECT: {
+            // A random student's subject
+            const vector<Student*>& students = component >= 0 ? config.getComponents()[component].students : config.getStudentVector();
+            if ( students.empty() ) break;
+
+            Student* chosen = students[ random->Generate( (int)students.size() - 1 ) ];
+            const StudentConstraints& constraints = config.getConstraints(chosen);
+
+            // The rows of a few tutors who teach it
+            int added = 0;
+            for (vector<int>::iterator t = tutors.begin(); t != tutors.end() && added < SUBJECT_TUTORS; t++) {
+                if ( constraints.proficiency[*t] < 0 ) continue;
+
+                for (int time = 0; time < SLOTS_IN_DAY; time++)
+                    region.push_back( *t * SLOTS_IN_DAY + time );
+                added++;
+            }
+
+            // And as many of the subject's interviews as there's room for, wherever they are now, or wherever in
+            //   the component's rows
+            vector<Student*> candidates;
+            for (vector<Student*>::const_iterator it = students.begin(); it != students.end(); it++) {
+                if ( (*it)->getSubject() != chosen->getSubject() ) continue;
+                if ( component >= 0 && config.componentOfTutor( chromo->getSlot(*it) / SLOTS_IN_DAY ) != component ) continue;
+                candidates.push_back(*it);
+            }
+            shuffle( candidates, random );
+
+            for (vector<Student*>::iterator it = candidates.begin(); it != candidates.end() && (int)freed.size() < maxFreed; it++)
+                freeSlot( chromo, chromo->getSlot(*it), maxFreed, freed, region );
+            break;
+        }
+
+        case TT_LNS_TUTORS: {
+            // As much of two tutors' rows as there's room for
+            vector<int> slots;
+            for (int i = 0; i < 2 && i < (int)tutors.size(); i++)
+                for (int time = 0; time < SLOTS_IN_DAY; time++)
+                    slots.push_back( tutors[i] * SLOTS_IN_DAY + time );
+            shuffle( slots, random );
+
+            for (vector<int>::iterator it = slots.begin(); it != slots.end(); it++)
+                freeSlot( chromo, *it, maxFreed, freed, region );
+            break;
+        }
+
+        default:
+            break;
+    }
+}
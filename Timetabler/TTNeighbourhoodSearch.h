@@ -0,0 +1,61 @@
+//
+//  TTNeighbourhoodSearch.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTNeighbourhoodSearch__
+#define __Timetabler__TTNeighbourhoodSearch__
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <future>
+
+#include "TTChromosone.h"
+#include "TTBranchAndBound.h"
+
+// Which part of the timetable large neighbourhood search destroys
+enum TTNeighbourhood {
+    TT_LNS_SESSION,     // one session (third of the day) of a few tutors
+    TT_LNS_SUBJECT,     // some interviews in one subject, which can go anywhere in the rows of a few tutors who teach it
+    TT_LNS_TUTORS,      // the whole rows of two tutors
+    TT_LNS_NEIGHBOURHOODS
+};
+
+// Large neighbourhood search: empty part of a timetable, then put the students back in the best possible
+// way with TTBranchAndBound. Each search only ever moves the students it freed, so it's safe to run several
+// on different copies of the same timetable at once. A search can be kept to one component's tutors' rows
+// (see Configuration::getComponents), and since the components share no tutors, each can be searched on a
+// thread of its own and the results put back together: see searchComponents.
+class TTNeighbourhoodSearch {
+
+public:
+
+    // Destroy and re-optimise a neighbourhood of the given kind iterations times, starting from start and keeping each
+    //   improvement. Each sub-problem frees at most maxFreed students and gives up after maxNodes nodes.
+    //   Returns a new chromosome holding the improved timetable, or NULL if nothing was found. If cancel is given,
+    //   the search stops as soon as it's set, returning whatever it's found so far. If component isn't -1, only
+    //   that component's rows are destroyed
+    static Chromosone* search(const Chromosone* start, TTNeighbourhood neighbourhood, int iterations, int maxFreed, long long maxNodes, unsigned long seed, const atomic<bool>* cancel = NULL, int component = -1);
+
+    // Search each component of start on its own as search does, sharing the iterations out between them by their
+    //   numbers of students, on up to threads threads at once, then put their rows back together. The searches
+    //   never move the same students, but a student's interviews in different components still score against
+    //   each other, so the whole only stands if it beats the best component's timetable on its own. Returns
+    //   whichever's better, or NULL if no component improved
+    static Chromosone* searchComponents(const Chromosone* start, TTNeighbourhood neighbourhood, int iterations, int maxFreed, long long maxNodes, unsigned long seed, int threads, const atomic<bool>* cancel = NULL);
+
+    // Pick a random neighbourhood of the given kind: the students to free and the slots they may go in. If component
+    //   isn't -1, the slots are all in its tutors' rows
+    static void destroy(const Chromosone* chromo, TTNeighbourhood neighbourhood, int maxFreed, GaRandomInteger* random, vector<Student*>& freed, vector<int>& region, int component = -1);
+
+private:
+
+    // Add slot to the region and free everyone in it, as long as that leaves no more than maxFreed freed. Returns false if it didn't
+    static bool freeSlot(const Chromosone* chromo, int slot, int maxFreed, vector<Student*>& freed, vector<int>& region);
+};
+
+#endif /* defined(__Timetabler__TTNeighbourhoodSearch__) */
@@ -0,0 +1,157 @@
+//
+//  TTOperatorScheduler.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTOperatorScheduler.h"
+
+// Number of uses between updates of the probabilities
+#define UPDATE_INTERVAL 1000
+
+TTOperatorScheduler::TTOperatorScheduler(const TTOperatorSet& initial, double minProbability, double learningRate, double decay) :
+    _numEnabled(0),
+    _minProbability(minProbability),
+    _learningRate(learningRate),
+    _decay(decay),
+    _sinceUpdate(0)
+{
+    double total = 0;
+    for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+        _enabled[i] = initial.getWeight( (TTOperator)i ) > 0;
+        if (_enabled[i]) {
+            _numEnabled++;
+            total += initial.getWeight( (TTOperator)i );
+        }
+    }
+    
+    for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+        _probabilities[i] = _enabled[i] ? initial.getWeight( (TTOperator)i ) / total : 0;
+        
+        _uses[i] = _improvements[i] = _gain[i] = _time[i] = 0;
+        _lastUses[i] = _lastGain[i] = _lastTime[i] = 0;
+        _rate[i] = 0;
+        _mergedUses[i] = _mergedImprovements[i] = _mergedGain[i] = _mergedTime[i] = 0;
+    }
+}
+
+TTOperator TTOperatorScheduler::choose(double random) const {
+    
+    // The probabilities might be part way through an update, so don't rely on them adding up to 1
+    double probabilities[TT_NUM_OPERATORS];
+    double total = 0;
+    
+    for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+        probabilities[i] = _probabilities[i].load( memory_order_relaxed );
+        total += probabilities[i];
+    }
+    
+    double target = random * total;
+    
+    int chosen = TT_OP_MOVE;
+    for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+        if ( !_enabled[i] ) continue;
+        chosen = i;
+        if (target < probabilities[i]) break;
+        target -= probabilities[i];
+    }
+    
+    return (TTOperator)chosen;
+}
+
+void TTOperatorScheduler::record(TTOperator op, float gain, long long nanoseconds) {
+    
+    _uses[op].fetch_add( 1, memory_order_relaxed );
+    _time[op].fetch_add( nanoseconds, memory_order_relaxed );
+    
+    if (gain > 0) {
+        _improvements[op].fetch_add( 1, memory_order_relaxed );
+        _gain[op].fetch_add( (long long)(gain * 1e6), memory_order_relaxed );
+    }
+    
+    if ( ++_sinceUpdate >= UPDATE_INTERVAL && _updateMutex.try_lock() ) {
+        _sinceUpdate = 0;
+        update();
+        _updateMutex.unlock();
+    }
+}
+
+void TTOperatorScheduler::update() {
+    
+    // Smooth each operator's gain per microsecond since the last update. Operators that weren't used keep their old rate
+    int best = -1;
+    
+    for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+        if ( !_enabled[i] ) continue;
+        
+        long long uses = _uses[i], gain = _gain[i], time = _time[i];
+        
+        if (uses > _lastUses[i] && time > _lastTime[i]) {
+            double rate = ( (gain - _lastGain[i]) / 1e6 ) / ( (time - _lastTime[i]) / 1e3 );
+            _rate[i] = _decay * _rate[i] + (1 - _decay) * rate;
+        }
+        
+        _lastUses[i] = uses;
+        _lastGain[i] = gain;
+        _lastTime[i] = time;
+        
+        if ( _rate[i] > 0 && (best < 0 || _rate[i] > _rate[best]) ) best = i;
+    }
+    
+    // Nothing's gaining anything, so we've no reason to change
+    if (best < 0) return;
+    
+    // Pursue the best: move its probability towards maxProbability and everyone else's towards minProbability
+    double maxProbability = 1 - (_numEnabled - 1) * _minProbability;
+    
+    for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+        if ( !_enabled[i] ) continue;
+        
+        double target = (i == best) ? maxProbability : _minProbability;
+        double p = _probabilities[i];
+        _probabilities[i] = p + _learningRate * (target - p);
+    }
+}
+
+void TTOperatorScheduler::merge(const vector<TTOperatorScheduler*>& replicas) {
+    
+    if ( replicas.empty() ) return;
+    
+    double probabilities[TT_NUM_OPERATORS] = {0};
+    
+    for (vector<TTOperatorScheduler*>::const_iterator it = replicas.begin(); it != replicas.end(); it++) {
+        TTOperatorScheduler* replica = *it;
+        
+        for (int i = 0; i < TT_NUM_OPERATORS; i++) {
+            long long uses = replica->_uses[i], improvements = replica->_improvements[i];
+            long long gain = replica->_gain[i], time = replica->_time[i];
+            
+            _uses[i] += uses - replica->_mergedUses[i];
+            _improvements[i] += improvements - replica->_mergedImprovements[i];
+            _gain[i] += gain - replica->_mergedGain[i];
+            _time[i] += time - replica->_mergedTime[i];
+            
+            replica->_mergedUses[i] = uses;
+            replica->_mergedImprovements[i] = improvements;
+            replica->_mergedGain[i] = gain;
+            replica->_mergedTime[i] = time;
+            
+            probabilities[i] += replica->_probabilities[i] / replicas.size();
+        }
+    }
+    
+    for (int i = 0; i < TT_NUM_OPERATORS; i++)
+        _probabilities[i] = probabilities[i];
+}
+
+const char* TTOperatorScheduler::getName(TTOperator op) {
+    switch (op) {
+        case TT_OP_MOVE: return "move";
+        case TT_OP_SWAP: return "swap";
+        case TT_OP_EJECTION_CHAIN: return "ejection";
+        case TT_OP_KEMPE_CHAIN: return "Kempe";
+        default: return "?";
+    }
+}
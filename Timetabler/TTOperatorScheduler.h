@@ -0,0 +1,86 @@
+//
+//  TTOperatorScheduler.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTOperatorScheduler__
+#define __Timetabler__TTOperatorScheduler__
+
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "TTChromosone.h"
+
+// Adaptive operator selection. Every use of an operator is credited with the score it gained and the time
+// it took, and the probabilities of choosing each operator are periodically moved towards whichever one
+// has recently gained the most per microsecond (adaptive pursuit, a multi-armed bandit policy). Every
+// enabled operator keeps at least minProbability, so that it can be picked up again if the run changes
+// phase. Operators with no weight in the starting set are never chosen.
+// choose() and record() can be called from any number of threads at once.
+class TTOperatorScheduler {
+    
+    bool _enabled[TT_NUM_OPERATORS];
+    int _numEnabled;
+    
+    double _minProbability;
+    double _learningRate;   // fraction of the way the probabilities move towards their targets at each update
+    double _decay;          // weight given to the previous gain rate when smoothing it
+    
+    // Running totals, added to by every thread
+    atomic<long long> _uses[TT_NUM_OPERATORS];
+    atomic<long long> _improvements[TT_NUM_OPERATORS];  // uses that gained anything
+    atomic<long long> _gain[TT_NUM_OPERATORS];          // score gained, in millionths
+    atomic<long long> _time[TT_NUM_OPERATORS];          // nanoseconds spent
+    
+    atomic<double> _probabilities[TT_NUM_OPERATORS];
+    
+    // Uses since the probabilities were last updated
+    atomic<int> _sinceUpdate;
+    
+    // Whichever thread takes this does the update. The rest carry on without waiting
+    mutex _updateMutex;
+    
+    // Totals at the last update and smoothed gain per microsecond. Only touched while holding _updateMutex
+    long long _lastUses[TT_NUM_OPERATORS];
+    long long _lastGain[TT_NUM_OPERATORS];
+    long long _lastTime[TT_NUM_OPERATORS];
+    double _rate[TT_NUM_OPERATORS];
+    
+    // Totals already added to another scheduler by merge(). Only used when this is one of several replicas
+    long long _mergedUses[TT_NUM_OPERATORS];
+    long long _mergedImprovements[TT_NUM_OPERATORS];
+    long long _mergedGain[TT_NUM_OPERATORS];
+    long long _mergedTime[TT_NUM_OPERATORS];
+    
+    // Move the probabilities towards the operator with the best recent gain rate
+    void update();
+    
+public:
+    
+    // Start with the probabilities in initial
+    TTOperatorScheduler(const TTOperatorSet& initial, double minProbability = 0.02, double learningRate = 0.2, double decay = 0.8);
+    
+    // Choose an operator, given a random number in [0, 1)
+    TTOperator choose(double random) const;
+    
+    // Credit op with one use that changed the score by gain (losses count as no gain) in the given time
+    void record(TTOperator op, float gain, long long nanoseconds);
+    
+    // Add what each replica has recorded since it was last merged to these totals and show the mean of their
+    //   probabilities, so that one scheduler can report for several that are each used by a single thread.
+    //   Call it while none of the replicas are in use
+    void merge(const vector<TTOperatorScheduler*>& replicas);
+    
+    inline long long getUses(TTOperator op) const { return _uses[op].load(); }
+    inline long long getImprovements(TTOperator op) const { return _improvements[op].load(); }
+    inline double getProbability(TTOperator op) const { return _probabilities[op].load(); }
+    
+    static const char* getName(TTOperator op);
+};
+
+#endif /* defined(__Timetabler__TTOperatorScheduler__) */
@@ -0,0 +1,101 @@
+//
+//  TTRepair.cpp
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "TTRepair.h"
+
+#include <climits>
+
+int TTRepair::repair(Chromosone* chromo) {
+    
+    const vector<list<Student*> >& slots = chromo->GetSlots();
+    
+    vector<int> stacked;
+    for (int slot = 0; slot < (int)slots.size(); slot++)
+        if ( slots[slot].size() > 1 ) stacked.push_back(slot);
+    
+    return repair(chromo, stacked);
+}
+
+int TTRepair::repair(Chromosone* chromo, const vector<int>& stacked) {
+    
+    Configuration& config = Configuration::getInstance();
+    const vector<list<Student*> >& slots = chromo->GetSlots();
+    
+    // Pick out everyone who'll have to move
+    vector<Student*> extras;
+    
+    for (vector<int>::const_iterator slot = stacked.begin(); slot != stacked.end(); slot++) {
+        if ( slots[*slot].size() < 2 ) continue;
+        
+        // The first student who can do the slot stays, or the first student if nobody can
+        Student* stays = slots[*slot].front();
+        for (list<Student*>::const_iterator it = slots[*slot].begin(); it != slots[*slot].end(); it++) {
+            if ( config.getConstraints(*it).canDoSlot[*slot] ) {
+                stays = *it;
+                break;
+            }
+        }
+        
+        for (list<Student*>::const_iterator it = slots[*slot].begin(); it != slots[*slot].end(); it++)
+            if (*it != stays) extras.push_back(*it);
+    }
+    
+    if ( extras.empty() ) return 0;
+    
+    int relocated = 0;
+    
+    for (vector<Student*>::iterator it = extras.begin(); it != extras.end(); it++) {
+        int from = chromo->getSlot(*it);
+        int to = nearestFreeSlot(chromo, *it, from);
+        if (to < 0) continue;
+        
+        chromo->applyMove( TTMove(*it, from, to) );
+        relocated++;
+    }
+    
+    _repairs++;
+    _conflicts += extras.size();
+    _relocated += relocated;
+    
+    return relocated;
+}
+
+int TTRepair::nearestFreeSlot(const Chromosone* chromo, Student* student, int from) {
+    
+    const StudentConstraints& constraints = Configuration::getInstance().getConstraints(student);
+    const vector<list<Student*> >& slots = chromo->GetSlots();
+    
+    int time = from % SLOTS_IN_DAY;
+    int tutor = from / SLOTS_IN_DAY;
+    
+    int best = -1, bestDistance = INT_MAX;
+    
+    for (vector<int>::const_iterator it = constraints.feasibleSlots.begin(); it != constraints.feasibleSlots.end(); it++) {
+        
+        int slot = *it;
+        if ( !slots[slot].empty() ) continue;
+        
+        // Closest in time first, so the student stays in the same session as their other interviews. Same tutor breaks ties
+        int distance = 2 * abs( slot % SLOTS_IN_DAY - time ) + (slot / SLOTS_IN_DAY != tutor);
+        if (distance >= bestDistance) continue;
+        
+        // Not at the same time as another of their interviews
+        bool clash = false;
+        for (vector<Student*>::const_iterator sibling = constraints.siblings.begin(); sibling != constraints.siblings.end(); sibling++)
+            if ( *sibling != student && chromo->getSlot(*sibling) % SLOTS_IN_DAY == slot % SLOTS_IN_DAY ) clash = true;
+        if (clash) continue;
+        
+        best = slot;
+        bestDistance = distance;
+        
+        // Nothing can be closer than the same time with another tutor
+        if (distance == 1) break;
+    }
+    
+    return best;
+}
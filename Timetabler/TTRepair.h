@@ -0,0 +1,52 @@
+//
+//  TTRepair.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTRepair__
+#define __Timetabler__TTRepair__
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+
+#include "TTChromosone.h"
+
+// Unstacks the students that a crossover left sharing a slot, rather than leaving it to many generations of
+// random mutation. Each slot keeps one student and the others go to the nearest empty slot they can do (see
+// StudentConstraints::canDoSlot), which is always in their own component's rows, at a time none of their other
+// interviews are at. Anyone with nowhere to go
+// stays put. The crossovers hand over the slots they stacked as they fill the child in, and whether a slot's
+// occupied is read straight off the child, so nothing looks at the slots that aren't in conflict: each student
+// moved costs at most one pass over their feasible slots, and a repair takes time linear in the number of
+// conflicts. repair() can be called from any number of threads at once.
+class TTRepair {
+    
+    // Running totals, added to by every thread
+    atomic<long long> _repairs;     // children that had any stacked slots
+    atomic<long long> _conflicts;   // students found sharing a slot, not counting the one that stays
+    atomic<long long> _relocated;   // students moved to an empty slot
+    
+    // The nearest empty slot to from that student can do, or -1 if there isn't one
+    static int nearestFreeSlot(const Chromosone* chromo, Student* student, int from);
+    
+public:
+    
+    TTRepair() : _repairs(0), _conflicts(0), _relocated(0) {}
+    
+    // Unstack chromo's shared slots, given each slot it has more than one student in once (any others are skipped).
+    //   Returns the number of students moved
+    int repair(Chromosone* chromo, const vector<int>& stacked);
+    
+    // As above, for a chromosome built without keeping track of its stacked slots. Takes a pass over every slot to find them
+    int repair(Chromosone* chromo);
+    
+    inline long long getRepairs() const { return _repairs; }
+    inline long long getConflicts() const { return _conflicts; }
+    inline long long getRelocated() const { return _relocated; }
+};
+
+#endif /* defined(__Timetabler__TTRepair__) */
@@ -0,0 +1,93 @@
+//
+//  TTWeights.h
+//  Timetabler
+//
+//  Created by agent on 18/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Timetabler__TTWeights__
+#define __Timetabler__TTWeights__
+
+#include <cmath>
+
+// Every weight in the score is a whole number of 1/SCORE_UNITS of a point, so that scores add up exactly in
+//  integers and come out the same whatever order they're added up in
+#define SCORE_UNITS 1200
+
+// The individual criteria each interview (or, for stability, each slot) is scored on, finer than TTObjective
+enum TTCriterion {
+    TT_CRIT_OVERLAP,                // nobody else in the slot
+    TT_CRIT_PROFICIENCY,            // the tutor teaches the subject
+    TT_CRIT_TUTOR_AVAILABILITY,     // the tutor can do the time
+    TT_CRIT_STUDENT_AVAILABILITY,   // the student can do the time
+    TT_CRIT_ENGAGEMENTS,            // the student has no other interview at the time
+    TT_CRIT_GROUPING,               // all the student's interviews are in the same session
+    TT_CRIT_PAIRING,                // the student sees the tutor once
+    TT_CRIT_PREV_TUTOR,             // the student hasn't seen the tutor before
+    TT_CRIT_STABILITY,              // the slot matches the previous solution
+    TT_NUM_CRITERIA
+};
+
+// The minor terms of a student's score that TTFitness can leave out of its evaluation when they're given no weight,
+//   or can't tell timetables apart (see Configuration::processTerms). Combined as flags, they pick which
+//   specialisation of the scoring is used. Grouping is still checked without its term, as a student whose
+//   interviews aren't grouped doesn't meet the essential requirements either way
+enum TTTerm {
+    TT_TERM_GROUPING = 1,
+    TT_TERM_PAIRING = 2,
+    TT_TERM_PREV_TUTOR = 4,
+    TT_NUM_PLANS = 8
+};
+
+// What each criterion is worth, in SCORE_UNITS. Proficiency's is for a tutor of proficiency 1, and grouping's is
+//   for each of the student's other interviews in the same session. Read from the config file's #weights block,
+//   in points, e.g. "pairing = 0.5"
+struct TTWeights {
+
+    long long units[TT_NUM_CRITERIA];
+
+    // The defaults
+    TTWeights() {
+        // Overlapping is particularly bad, so should merit a higher penalty than other lacking major requirements
+        units[TT_CRIT_OVERLAP] = SCORE_UNITS * 3 / 2;
+        units[TT_CRIT_PROFICIENCY] = SCORE_UNITS;
+        units[TT_CRIT_TUTOR_AVAILABILITY] = SCORE_UNITS;
+        units[TT_CRIT_STUDENT_AVAILABILITY] = SCORE_UNITS;
+        units[TT_CRIT_ENGAGEMENTS] = SCORE_UNITS;
+        units[TT_CRIT_GROUPING] = SCORE_UNITS / 12;        // 0.5/6.0 a point: see TTFitness::scoreStudent for why it's so small
+        units[TT_CRIT_PAIRING] = SCORE_UNITS / 2;
+        units[TT_CRIT_PREV_TUTOR] = SCORE_UNITS / 10;
+        units[TT_CRIT_STABILITY] = SCORE_UNITS / 100;      // very low since we want all other requirements to take priority
+    }
+
+    inline bool isEnabled(TTCriterion criterion) const { return units[criterion] != 0; }
+
+    inline float getPoints(TTCriterion criterion) const { return (float)units[criterion] / SCORE_UNITS; }
+    inline void setPoints(TTCriterion criterion, double points) { units[criterion] = llround( points * SCORE_UNITS ); }
+
+    // The minor terms that have any weight, as TTTerm flags
+    inline int getTerms() const {
+        return ( isEnabled(TT_CRIT_GROUPING) ? TT_TERM_GROUPING : 0 ) |
+               ( isEnabled(TT_CRIT_PAIRING) ? TT_TERM_PAIRING : 0 ) |
+               ( isEnabled(TT_CRIT_PREV_TUTOR) ? TT_TERM_PREV_TUTOR : 0 );
+    }
+
+    // The criterion's key in the #weights block
+    static inline const char* getKey(TTCriterion criterion) {
+        switch (criterion) {
+            case TT_CRIT_OVERLAP: return "overlap";
+            case TT_CRIT_PROFICIENCY: return "proficiency";
+            case TT_CRIT_TUTOR_AVAILABILITY: return "tutorAvailability";
+            case TT_CRIT_STUDENT_AVAILABILITY: return "studentAvailability";
+            case TT_CRIT_ENGAGEMENTS: return "engagements";
+            case TT_CRIT_GROUPING: return "grouping";
+            case TT_CRIT_PAIRING: return "pairing";
+            case TT_CRIT_PREV_TUTOR: return "prevTutor";
+            case TT_CRIT_STABILITY: return "stability";
+            default: return "?";
+        }
+    }
+};
+
+#endif /* defined(__Timetabler__TTWeights__) */
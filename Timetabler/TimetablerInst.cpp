@@ -8,12 +8,32 @@
 
 #include "TimetablerInst.h"
 
+#include <thread>
+#include <chrono>
+
 using namespace Population;
 using namespace Population::ReplacementOperations;
 using namespace Population::SelectionOperations;
 using namespace Algorithm::SimpleAlgorithms;
 using namespace Algorithm::StopCriterias;
 
+TTSolver TimetablerInst::_solver = TT_SOLVER_GA;
+bool TimetablerInst::_blockCrossover = false;
+bool TimetablerInst::_groupCrossover = false;
+bool TimetablerInst::_adaptiveOperators = false;
+bool TimetablerInst::_repairCrossover = false;
+TTInitMode TimetablerInst::_initMode = TT_INIT_RANDOM;
+int TimetablerInst::_matchingSeeds = 0;
+unsigned long TimetablerInst::_seed = 0;
+int TimetablerInst::_candidates = 1;
+bool TimetablerInst::_pathRelinking = false;
+int TimetablerInst::_restarts = 0;
+int TimetablerInst::_searchWorkers = 0;
+int TimetablerInst::_exactLimit = 0;
+bool TimetablerInst::_warmRestart = false;
+vector<vector<list<int> > > TimetablerInst::_carried;
+double TimetablerInst::_timeLimit = 0;
+
 TimetablerInst* TimetablerInst::_instance = new TimetablerInst();
 
 void TTObserver::NewBestChromosome(const GaChromosome& newChromosome, const GaAlgorithm& algorithm) {
@@ -36,6 +56,8 @@ void TTObserver::EvolutionStateChanged(GaAlgorithmState newState, const GaAlgori
         GaChromosomePtr result;
         algorithm.GetPopulation(0).GetBestChromosomes(&result, 0, 1); // store best chromosone in result
         
+        reportBreakdown(*result);
+        
         if (_funcComplete != NULL)
             _funcComplete(result);
         
@@ -48,7 +70,26 @@ void TTObserver::EvolutionStateChanged(GaAlgorithmState newState, const GaAlgori
     
 }
 
-TimetablerInst::TimetablerInst()
+void TTObserver::reportBreakdown(const GaChromosome& chromosome) {
+    
+    // Where it falls short: each criterion met out of how many times it's checked, and its score
+    TTBreakdown breakdown = TTFitness::breakdown( dynamic_cast<const Chromosone*>(&chromosome) );
+    for (int i = 0; i < TT_NUM_CRITERIA; i++) {
+        if ( !breakdown.of[i] ) continue;
+        printf("%s%s %i/%i (%.2f)", i ? ", " : "  ", TTFitness::getName( (TTCriterion)i ), breakdown.met[i], breakdown.of[i], breakdown.getPoints( (TTCriterion)i ));
+    }
+    printf("\n");
+    
+    ( outputBreakdownCSV::getInstance() )((char*)"solution_breakdown.csv", chromosome);
+}
+
+void TTObserver::PopulationRestarted(int restart, double diversity, const GaAlgorithm& algorithm) {
+    printf("Restart %i at generation %i: population had collapsed to %.1f%% diversity\n", restart, algorithm.GetAlgorithmStatistics().GetCurrentGeneration(), diversity * 100);
+}
+
+
+TimetablerInst::TimetablerInst() :
+_crowdedTournament(&_crowdingReplacement)
 {
     
     // initialize GAL internal structures
@@ -61,10 +102,29 @@ TimetablerInst::TimetablerInst()
 	// mutation probability: 4%
 	// number of moved students per mutation: 2
     // prob of doing a swap instead of a mutation: 10%
+    // crossover over individual interviews, or over students if _groupCrossover (see benchmarkCrossover)
 //	_chromosomeParams = new GaChromosomeParams( 0.03F, 2, false, 0.8F, 2 );
     
 
-    _chromosomeParams = new TTChromosomeParams( 0.04F, 2, 0.1, false, 0.8F, 2 );
+    _chromosomeParams = new TTChromosomeParams( 0.04F, 2, 0.1, false, 0.8F, 2, _groupCrossover ? TT_CROSSOVER_GROUP : TT_CROSSOVER_POINT );
+    
+    // Occasionally use the compound moves too, to get out of plateaus where every slot a student could move to is taken
+    _chromosomeParams->setOperatorWeight( TT_OP_EJECTION_CHAIN, 0.05 );
+    _chromosomeParams->setOperatorWeight( TT_OP_KEMPE_CHAIN, 0.05 );
+    
+    _chromosomeParams->setInitMode(_initMode);
+    _chromosomeParams->setInitSeed(_seed);
+    
+    // Let each chromosome tune its own mutation probability, size and probSwap, starting from the values above
+    _chromosomeParams->setSelfAdaptationRate( 0.3 );
+    
+    // If asked to, start from those weights and spend more time on whichever operators are paying off at the moment
+    _scheduler = _adaptiveOperators ? new TTOperatorScheduler( _chromosomeParams->getOperators() ) : NULL;
+    _chromosomeParams->setScheduler(_scheduler);
+    
+    // If asked to, unstack students that crossover leaves sharing a slot straight away, rather than waiting for mutation to do it
+    _repair = _repairCrossover ? new TTRepair() : NULL;
+    _chromosomeParams->setRepair(_repair);
 
     
 	// make CCB with fallowing setup:
@@ -73,7 +133,9 @@ TimetablerInst::TimetablerInst()
 	// set fitness comparator for maximizing fitness value
 	// use previously defined chromosome's parameters
 
-    _ccb = new GaChromosomeDomainBlock<list<Student*> >( NULL, &_crossoverOperation, &_mutationOperation, &_fitnessOperation, GaFitnessComparatorCatalogue::Instance().GetEntryData( "GaMaxFitnessComparator" ), _chromosomeParams );
+    GaCrossoverOperation* crossover = _blockCrossover ? (GaCrossoverOperation*)&_blockCrossoverOperation : &_crossoverOperation;
+    
+    _ccb = new GaChromosomeDomainBlock<list<Student*> >( NULL, crossover, &_mutationOperation, &_fitnessOperation, &_fitnessComparator, _chromosomeParams );
     
 	// make prototype of chromosome
 	_prototype = new Chromosone( _ccb );
@@ -86,6 +148,26 @@ TimetablerInst::TimetablerInst()
 	// population tracks 5 best and 5 worst chromosomes
 	GaPopulationParameters populationParams( 100, false, false, false, 5, 5 );
     
+    // Parallel tempering and the island model run one replica/island per hardware thread
+    int replicas = max( 2, (int)thread::hardware_concurrency() );
+    
+    // The annealers only need to hold the best timetable of each chain
+    if (_solver == TT_SOLVER_ANNEALING)
+        populationParams = GaPopulationParameters( 1, false, false, false, 1, 1 );
+    else if (_solver == TT_SOLVER_TEMPERING)
+        populationParams = GaPopulationParameters( replicas, false, false, false, 1, 1 );
+    
+    // NSGA-II needs room for a spread of trade-offs along the front as well as the best
+    else if (_solver == TT_SOLVER_NSGA)
+        populationParams = GaPopulationParameters( 200, false, false, false, 5, 5 );
+    
+    // The annealers' few chains get better starting points from greedy construction than from the matching seeds
+    _matchingSeedLimit = (_solver == TT_SOLVER_ANNEALING || _solver == TT_SOLVER_TEMPERING) ? 0 : _matchingSeeds;
+    
+    // Start from as many of the last run's timetables as the population tracks as its best. The rest are built
+    //   fresh, so that a warm start still has the seeds' variety to work with
+    _carriedLimit = populationParams.GetBestTrackCount();
+    
 	// make parameters for selection operation
 	// selection will choose 16 chromosomes
 	// but only 8 best of them will be stored in selection result set
@@ -100,7 +182,9 @@ TimetablerInst::TimetablerInst()
     
 	// make parameters for coupling operation
 	// coupling operation will produce 8 new chromosomes from selected parents
-	GaCouplingParams coupParam( 8, false );
+	// making up to _candidates candidates for each, but stopping at the first that beats its worse parent
+	// NSGA-II makes one candidate per child, since the others would be chosen by the weighted score it does without
+	TTBestOfCouplingParams coupParam( 8, false, _solver == TT_SOLVER_NSGA ? 1 : _candidates, true );
     
 	// make population configuration
 	// use defined population parameters
@@ -108,14 +192,23 @@ TimetablerInst::TimetablerInst()
 	// use selection operation which randomly selects chromosomes
 	// use replacement operation which randomly chooses chromosomes from population
 	// which are going to be replaced, but keeps best chromosomes
-	// use simple coupling
+	// use best-of-N coupling
 	// disable scaling
 	_populationConfig = new GaPopulationConfiguration ( populationParams, &_ccb->GetFitnessComparator(),
                                                        GaSelectionCatalogue::Instance().GetEntryData( "GaSelectRandom" ), &selParam,
                                                        GaReplacementCatalogue::Instance().GetEntryData( "GaReplaceRandom" ), &repParam,
-                                                       GaCouplingCatalogue::Instance().GetEntryData( "GaSimpleCoupling" ), &coupParam,
+                                                       &_couplingOperation, &coupParam,
                                                        NULL, NULL );
     
+    // or, for NSGA-II, crowded tournaments for selection and replacement by front and crowding distance
+    _pareto = NULL;
+    if (_solver == TT_SOLVER_NSGA) {
+        GaSelectionParams tournamentParams( 8 );
+        _populationConfig->SetOperation( &_crowdedTournament, &tournamentParams );
+        _populationConfig->SetOperation( &_crowdingReplacement, &repParam );
+        _pareto = &_crowdingReplacement;
+    }
+    
 	// make population
 	// with previously defined prototype of chromosomes and population configuration
 	_population = new GaPopulation( _prototype, _populationConfig );
@@ -129,7 +222,42 @@ TimetablerInst::TimetablerInst()
 #endif
     
 	// make incremental algorithm with periously defined population and parameters
-	_algorithm = new GaIncrementalAlgorithm( _population, algorithmParams );
+	// relinking pairs of elites on a thread of its own
+	// with _searchWorkers large neighbourhood searches running alongside
+	// restarting up to _restarts times, keeping the 5 best, once the best hasn't improved for 2000 generations
+	// and fewer than 5% of interviews differ from the best on average
+	// if, when it starts, no component has more than _exactLimit interviews, also solve exactly on other threads,
+	// giving up after 20 million nodes
+	if (_solver == TT_SOLVER_GA)
+        _algorithm = new TTExactAlgorithm( _population, algorithmParams, _exactLimit, 20000000, _pathRelinking, _searchWorkers, TTRestartParams( 2000, 0.05, _restarts, 5 ) );
+    
+    // or NSGA-II: the same incremental GA, but without the relinking, searches and restarts, which all work
+    //   towards the weighted score rather than the front
+    else if (_solver == TT_SOLVER_NSGA)
+        _algorithm = new TTIncrementalAlgorithm( _population, algorithmParams, false, 0, TTRestartParams( 2000, 0.05, 0, 5 ) );
+    
+    // or make annealer:
+    // one chain
+    // 2000 moves per step
+    // accept 50% of worsening moves to start with, decaying by 2% a step to 0.1%
+    // nudge temperature by 3% a step to track the target acceptance
+    // reheat to 30% of the starting temperature after 500 steps without improvement
+    else if (_solver == TT_SOLVER_ANNEALING)
+        _algorithm = new TTAnnealingAlgorithm( _population, TTAnnealingParams( 1, 2000, 0.5, 0.001, 0.98, 0.97, 500, 0.3 ) );
+    
+    // or make parallel tempering:
+    // one replica per hardware thread
+    // exchange neighbouring replicas every 2000 moves
+    // hottest replica accepts 50% of worsening moves, coldest is 1000 times colder
+    else if (_solver == TT_SOLVER_TEMPERING)
+        _algorithm = new TTTemperingAlgorithm( _population, TTAnnealingParams( replicas, 2000, 0.5, 0, 1, 1, 0, 1 ), 0.001 );
+    
+    // or make island model:
+    // one island per hardware thread, each configured like the GA's population
+    // islands synchronise every 100 generations
+    // each island sends its best to the next one round the ring every 20 generations
+    else
+        _algorithm = new TTIslandAlgorithm( _population, TTIslandParams( replicas, 100, 20, TT_MIGRATE_RING ) );
     
 	// make parameters for stop criteria based on fitness value
 	// stop when best chromosome reaches fitness value of 1
@@ -138,12 +266,15 @@ TimetablerInst::TimetablerInst()
 //    GaFitnessCriteriaParams criteriaParams( 1, GFC_MORE_THEN_EQUALS_TO, GSV_BEST_FITNESS );
 
 //    Keep trying until the fitness doesn't improve for 50000 generations
-    GaFitnessProgressCriteriaParams fitnessParams(0.00001, true, GFC_LESS_THEN_EQUALS_TO, GaStatValueType::GSV_BEST_FITNESS, 50000);
-//    GaFitnessProgressCriteriaParams fitnessParams(0.00001, true, GFC_LESS_THEN_EQUALS_TO, GaStatValueType::GSV_BEST_FITNESS, 500);
+//    An annealing step is 2000 moves rather than 8 children, so needs far fewer of them. 2000 allows a few reheats before giving up
+//    The islands are only checked every 100 generations
+    _historyDepth = 50000;
+    if (_solver == TT_SOLVER_ANNEALING || _solver == TT_SOLVER_TEMPERING) _historyDepth = 2000;
+    else if (_solver == TT_SOLVER_ISLANDS) _historyDepth = 500;
     
 	// sets algorithm's stop criteria (based on fitness improvement) and its parameters
 //	_algorithm->SetStopCriteria( GaStopCriteriaCatalogue::Instance().GetEntryData( "GaFitnessCriteria" ), &criteriaParams );
-    _algorithm->SetStopCriteria( GaStopCriteriaCatalogue::Instance().GetEntryData( "GaFitnessProgressCriteria" ), &fitnessParams );
+    useProgressCriteria();
     
 	// subscribe observer
 	_algorithm->SubscribeObserver( &_observer );
@@ -156,6 +287,8 @@ TimetablerInst::~TimetablerInst()
 	delete _algorithm;
     
     _bestAdded = false;
+    _matchingSeedsAdded = 0;
+    _carriedAdded = 0;
     
 	delete _population;
 	delete _populationConfig;
@@ -163,7 +296,143 @@ TimetablerInst::~TimetablerInst()
 	delete _prototype;
 	delete _ccb;
 	delete _chromosomeParams;
+	delete _scheduler;
+	delete _repair;
     
 	// Free resources used by GAL
 //	GaFinalize();
 }
+
+void TimetablerInst::useProgressCriteria() {
+    
+    // Stop once the best timetable hasn't improved for _historyDepth generations, ranked on the exact scores as the
+    //   population ranks them rather than on the best fitness, which a better timetable can have less of
+//    GaFitnessProgressCriteriaParams fitnessParams(0, true, GFC_LESS_THEN_EQUALS_TO, GaStatValueType::GSV_BEST_FITNESS, 500);
+    TTScoreProgressCriteriaParams progressParams(_historyDepth);
+    
+    _algorithm->SetStopCriteria( &_progressCriteria, &progressParams );
+    _couplingOperation.clearDeadline();
+}
+
+void TimetablerInst::startSolvingFor(double seconds, bool resume) {
+    
+    GaTimeCriteriaParams timeParams(seconds);
+    
+    _algorithm->SetStopCriteria( GaStopCriteriaCatalogue::Instance().GetEntryData( "GaTimeCriteria" ), &timeParams );
+    _couplingOperation.setDeadline( timeParams.GetDeadline() );
+    
+    _algorithm->StartSolving(resume);
+}
+
+GaChromosomePtr TimetablerInst::solveFor(double seconds) {
+    
+    startSolvingFor(seconds);
+    
+    // Every solver's a GaMultithreadingAlgorithm, whose threads all finish once it stops
+    dynamic_cast<GaMultithreadingAlgorithm*>(_algorithm)->WaitForThreads();
+    
+    GaChromosomePtr best;
+    _algorithm->GetPopulation(0).GetBestChromosomes( &best, 0, 1 );
+    
+    useProgressCriteria();
+    
+    return best;
+}
+
+void TimetablerInst::reportBreakdown() const {
+    
+    GaChromosomePtr best;
+    _algorithm->GetPopulation(0).GetBestChromosomes( &best, 0, 1 );
+    
+    TTObserver::reportBreakdown(*best);
+}
+
+void TimetablerInst::keepPopulation() {
+    
+    _carried.clear();
+    
+    if (!_warmRestart || !_instance) return;
+    
+    const GaPopulation& population = _instance->_algorithm->GetPopulation(0);
+    int size = population.GetCurrentSize();
+    
+    // Best first, ranked as the population ranks them, so that the next run starts from the best of this one
+    vector<const Chromosone*> ranked;
+    for (int i = 0; i < size; i++)
+        ranked.push_back( dynamic_cast<const Chromosone*>( population.GetAt(i).GetChromosome().GetRawPtr() ) );
+    stable_sort( ranked.begin(), ranked.end(), [](const Chromosone* a, const Chromosone* b) { return TTScoreComparator::compare(*a, *b) > 0; } );
+    
+    for (vector<const Chromosone*>::iterator it = ranked.begin(); it != ranked.end(); it++) {
+        const vector<list<Student*> >& slots = (*it)->GetSlots();
+        
+        vector<list<int> > layout( slots.size() );
+        for (int slot = 0; slot < (int)slots.size(); slot++)
+            for (list<Student*>::const_iterator s = slots[slot].begin(); s != slots[slot].end(); s++)
+                layout[slot].push_back( (*s)->getBaseID() );
+        
+        _carried.push_back(layout);
+    }
+}
+
+void TimetablerInst::removeTutorFromCarried(int tutorID) {
+    
+    for (vector<vector<list<int> > >::iterator it = _carried.begin(); it != _carried.end(); it++) {
+        int first = (tutorID - 1) * SLOTS_IN_DAY;
+        if ( first >= (int)(*it).size() ) continue;
+        
+        (*it).erase( (*it).begin() + first, (*it).begin() + min( first + SLOTS_IN_DAY, (int)(*it).size() ) );
+    }
+}
+
+void TimetablerInst::benchmarkCrossover(int numParents, int trials) {
+    
+    // Make some parents that look like the ones found later in a run, by hill climbing from random starting points
+    vector<GaChromosomePtr> parents;
+    double parentFitness = 0;
+    
+    for (int i = 0; i < numParents; i++) {
+        GaChromosomePtr parent = _prototype->MakeNewFromPrototype();
+        Chromosone* chromo = dynamic_cast<Chromosone*>( parent.GetRawPtr() );
+        
+        for (int j = 0; j < 20000; j++) {
+            TTMove move = TTMutation::randomMove( chromo, GaGlobalRandomBoolGenerator->Generate( _chromosomeParams->getProbSwap() ) );
+            if ( TTFitness::moveDelta( chromo, move ) < 0 )
+                chromo->undoMove(move);
+        }
+        
+        parent->RefreshFitness();
+        parentFitness += parent->GetFitness();
+        parents.push_back(parent);
+    }
+    
+    printf("Crossover benchmark: %i parents with mean fitness %f, %i trials\n", numParents, parentFitness / numParents, trials);
+    
+    const char* names[] = { "point", "group", "block" };
+    
+    for (int m = 0; m < 3; m++) {
+        
+        double childFitness = 0, seconds = 0;
+        int asGood = 0;
+        
+        for (int t = 0; t < trials; t++) {
+            const Chromosone* p1 = dynamic_cast<const Chromosone*>( parents[ GaGlobalRandomIntegerGenerator->Generate( numParents - 1 ) ].GetRawPtr() );
+            const Chromosone* p2 = dynamic_cast<const Chromosone*>( parents[ GaGlobalRandomIntegerGenerator->Generate( numParents - 1 ) ].GetRawPtr() );
+            
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            GaChromosomePtr child;
+            if (m == 0) child = _crossoverOperation.crossover( p1, p2, TT_CROSSOVER_POINT );
+            else if (m == 1) child = _crossoverOperation.crossover( p1, p2, TT_CROSSOVER_GROUP );
+            else child = _blockCrossoverOperation( p1, p2 );
+            seconds += chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+            
+            child->RefreshFitness();
+            childFitness += child->GetFitness();
+            
+            // Is the child at least as good as its worse parent?
+            if ( child->GetFitness() >= min( p1->GetFitness(), p2->GetFitness() ) ) asGood++;
+        }
+        
+        printf("  %s: mean child fitness %f, %.1f%% at least as good as the worse parent, %.1f us per crossover\n",
+               names[m], childFitness / trials, 100.0 * asGood / trials, 1e6 * seconds / trials);
+    }
+}
@@ -15,10 +15,27 @@
 using namespace Wt;
 
 #include "TTChromosone.h"
+#include "TTAnnealing.h"
+#include "TTIslands.h"
+#include "TTOperatorScheduler.h"
+#include "TTRepair.h"
+#include "TTIncremental.h"
+#include "TTExact.h"
+#include "TTCoupling.h"
+#include "TTMultiObjective.h"
 #include "output.h"
 
+// The available solvers
+enum TTSolver {
+    TT_SOLVER_GA,           // Incremental genetic algorithm (default)
+    TT_SOLVER_ANNEALING,    // Simulated annealing, see TTAnnealing.h
+    TT_SOLVER_TEMPERING,    // Parallel tempering, one replica per hardware thread
+    TT_SOLVER_ISLANDS,      // Island model GA, one island per hardware thread, see TTIslands.h
+    TT_SOLVER_NSGA          // NSGA-II over the criteria as separate objectives, see TTMultiObjective.h
+};
+
 
-class TTObserver : public GaObserverAdapter {
+class TTObserver : public GaObserverAdapter, public TTRestartObserver {
     
     SysEventObject _event; // event for callback
     
@@ -38,6 +55,12 @@ public:
     virtual void NewBestChromosome(const GaChromosome& newChromosome, const GaAlgorithm& algorithm);
     
 	virtual void EvolutionStateChanged(GaAlgorithmState newState, const GaAlgorithm& algorithm);
+    
+    virtual void PopulationRestarted(int restart, double diversity, const GaAlgorithm& algorithm);
+    
+    // Print how the timetable does on each criterion and write it to solution_breakdown.csv. Done once a run
+    //   completes, rather than on every new best, to keep the workers' callbacks cheap
+    static void reportBreakdown(const GaChromosome& chromosome);
 
 };
 
@@ -48,6 +71,63 @@ class TimetablerInst {
     // if we're using a previous solution, has it been added to the population yet?
     bool _bestAdded=false;
     
+    // number of matching seeds added to the population so far, and the number wanted
+    int _matchingSeedsAdded=0;
+    int _matchingSeedLimit=0;
+    
+    // How many of the timetables kept from the last run have been used, and the most that may be
+    int _carriedAdded=0;
+    int _carriedLimit=0;
+    
+    // Which solver new instances use
+    static TTSolver _solver;
+    
+    // Should new instances use TTBlockCrossover instead of TTCrossover?
+    static bool _blockCrossover;
+    
+    // Should new instances' crossovers keep each student's interviews together?
+    static bool _groupCrossover;
+    
+    // Should new instances choose their mutation operators adaptively?
+    static bool _adaptiveOperators;
+    
+    // Should new instances' crossovers unstack their children's shared slots?
+    static bool _repairCrossover;
+    
+    // How new instances build their starting population
+    static TTInitMode _initMode;
+    
+    // How many members of new instances' starting populations are seeded by Chromosone::constructMatching
+    static int _matchingSeeds;
+    
+    // Seed for new instances' starting populations. 0 for a different population every time
+    static unsigned long _seed;
+    
+    // Number of candidates the GA makes for each child, keeping the fittest
+    static int _candidates;
+    
+    // Should the GA relink its elites in the background?
+    static bool _pathRelinking;
+    
+    // Most times the GA may restart a stagnant population in a run
+    static int _restarts;
+    
+    // Number of large neighbourhood searches the GA keeps running alongside it
+    static int _searchWorkers;
+    
+    // Largest number of student-interviews in any one component for which the GA also tries to solve the problem exactly
+    static int _exactLimit;
+    
+    // Should keepPopulation keep anything?
+    static bool _warmRestart;
+    
+    // The population kept from the last run by keepPopulation, best first, as the baseIDs in each slot. Slots are
+    //   numbered by tutor ID as usual, so they're renumbered along with the tutors: see removeTutorFromCarried
+    static vector<vector<list<int> > > _carried;
+    
+    // Wall-clock time the GUI gives each solve, in seconds. 0 to run until the fitness stops improving
+    static double _timeLimit;
+    
 public:
     inline static TimetablerInst* getInstance() { return _instance; } // return global instance
     inline static void reset() {
@@ -59,6 +139,69 @@ public:
         }
     }
     
+    // Choose the solver. Takes effect on the next reset()
+    inline static void setSolver(TTSolver solver) { _solver = solver; }
+    inline static TTSolver getSolver() { return _solver; }
+    
+    // Choose the crossover operation. Takes effect on the next reset()
+    inline static void setBlockCrossover(bool block) { _blockCrossover = block; }
+    inline static void setGroupCrossover(bool group) { _groupCrossover = group; }
+    
+    // Choose between adaptive and fixed operator weights. Takes effect on the next reset()
+    inline static void setAdaptiveOperators(bool adaptive) { _adaptiveOperators = adaptive; }
+    
+    // Turn the crossovers' repair pass on or off. Takes effect on the next reset()
+    inline static void setRepairCrossover(bool repair) { _repairCrossover = repair; }
+    
+    // Choose how the starting population is built. Takes effect on the next reset()
+    inline static void setInitMode(TTInitMode mode) { _initMode = mode; }
+    inline static void setMatchingSeeds(int seeds) { _matchingSeeds = seeds; }
+    
+    // Fix the seed used to build the starting population, so that it's the same every run. Takes effect on the next reset()
+    inline static void setSeed(unsigned long seed) { _seed = seed; }
+    
+    // Set how many candidates the GA makes for each child. Takes effect on the next reset()
+    inline static void setCandidates(int candidates) { _candidates = candidates; }
+    
+    // Turn the GA's path relinking on or off. Takes effect on the next reset()
+    inline static void setPathRelinking(bool relinking) { _pathRelinking = relinking; }
+    
+    // Set how many times the GA may restart. Takes effect on the next reset()
+    inline static void setRestarts(int restarts) { _restarts = restarts; }
+    
+    // Set how many large neighbourhood searches the GA runs at once, 0 for none. Takes effect on the next reset()
+    inline static void setSearchWorkers(int workers) { _searchWorkers = workers; }
+    
+    // Set the largest component the GA tries to solve exactly, 0 for never. Takes effect on the next reset()
+    inline static void setExactLimit(int interviews) { _exactLimit = interviews; }
+    
+    // Turn warm restarts on or off. If on, keepPopulation() keeps the population for the next run to start from
+    inline static void setWarmRestart(bool warm) { _warmRestart = warm; }
+    
+    // Keep the current population for the next run to start from, instead of building a new one from scratch.
+    //   Call it before editing the configuration, while its students still exist, then reset(). Each kept
+    //   timetable is mapped onto the new configuration and repaired (see Chromosone::constructCarried)
+    static void keepPopulation();
+    inline static void discardPopulation() { _carried.clear(); }
+    inline static const vector<list<int> >& getCarried(int i) { return _carried[i]; }
+    
+    // The tutor with this ID has been removed and the ones after renumbered: drop their rows from the kept
+    //   timetables and move the later tutors' rows up to match. Their students are placed afresh
+    static void removeTutorFromCarried(int tutorID);
+    
+    // Should the next new chromosome be built from a kept timetable? Counts it as added if so. Only the best few
+    //   are wanted, so that the rest of the population is built fresh
+    inline bool carriedWanted() {
+        if ( _carriedAdded >= min( (int)_carried.size(), _carriedLimit ) ) return false;
+        _carriedAdded++;
+        return true;
+    }
+    inline int carriedAdded() const { return _carriedAdded; }
+    
+    // Set how long the GUI lets each solve run for, 0 for as long as it keeps improving
+    inline static void setTimeLimit(double seconds) { _timeLimit = seconds; }
+    inline static double getTimeLimit() { return _timeLimit; }
+    
     // Check if we've added the previous solution in yet
     // if not, return false and then set _bestAdded = true so that this method returns true henceforth
     inline bool bestAdded() {
@@ -68,15 +211,45 @@ public:
         return false;
     }
     
+    // Should the next new chromosome be seeded from a matching? Counts it as added if so
+    inline bool matchingSeedWanted() {
+        if (_matchingSeedsAdded >= _matchingSeedLimit) return false;
+        _matchingSeedsAdded++;
+        return true;
+    }
+    
 private:
 
     TTChromosomeParams* _chromosomeParams;
     
+    // NULL unless the operators are chosen adaptively
+    TTOperatorScheduler* _scheduler;
+    
+    // NULL unless the crossovers repair their children
+    TTRepair* _repair;
+    
 	TTCrossover _crossoverOperation;
     
+	TTBlockCrossover _blockCrossoverOperation;
+    
 	TTMutation _mutationOperation;
 
 	TTFitness _fitnessOperation;
+    // Ranks timetables on their exact scores, tier by tier: see TTScoreComparator
+    TTScoreComparator _fitnessComparator;
+    
+    // The usual stop criterion: see useProgressCriteria
+    TTScoreProgressCriteria _progressCriteria;
+    
+	TTBestOfCoupling _couplingOperation;
+    
+    // NSGA-II's replacement and selection. Only used by TT_SOLVER_NSGA
+    TTCrowdingReplacement _crowdingReplacement;
+    
+    TTCrowdedTournament _crowdedTournament;
+    
+    // NULL unless the solver's TT_SOLVER_NSGA
+    const TTCrowdingReplacement* _pareto;
 
 	GaChromosomeDomainBlock<list<Student*> >* _ccb;
     
@@ -90,6 +263,12 @@ private:
     
 	TTObserver _observer;
     
+    // Generations without improvement before the usual stop criterion stops the algorithm
+    int _historyDepth;
+    
+    // Go back to the usual stop criterion and clear any deadline
+    void useProgressCriteria();
+    
 public:
 
     
@@ -109,6 +288,30 @@ public:
     
 	inline const TTObserver& getObserver() const { return _observer; }
     
+    inline const TTOperatorScheduler* getScheduler() const { return _scheduler; }
+    
+    inline const TTRepair* getRepair() const { return _repair; }
+    
+    // NULL unless the solver's TT_SOLVER_NSGA
+    inline const TTCrowdingReplacement* getPareto() const { return _pareto; }
+    
+    // Anytime solving: start the algorithm with a deadline seconds from now, on a monotonic clock, in place of the usual
+    //   stop criterion. The GA starts no more children once it's passed, so the run overruns it by at most one child's
+    //   work. The deadline stays until reset() or solveFor(). If resume, carry on from where the algorithm was paused
+    void startSolvingFor(double seconds, bool resume = false);
+    
+    // Solve for at most seconds and return the best timetable found by then. Blocks until the algorithm's threads
+    //   finish, which is sooner if the usual criteria would stop it (a proof of optimality, say), then goes back to
+    //   the usual stop criterion. The entry point for solving from the command line: see "--solve" in main()
+    GaChromosomePtr solveFor(double seconds);
+    
+    // Report the current best timetable's breakdown as a completed run does: see TTObserver::reportBreakdown
+    void reportBreakdown() const;
+    
+    // Compare the crossover operations on numParents locally-optimised parents, printing the average child fitness
+    //   and the time per crossover over the given number of trials
+    void benchmarkCrossover(int numParents, int trials);
+    
     // convenience, to register callback function for completion
     inline void registerObserverFunc(function<void(GaChromosomePtr result)> funcComplete) { _observer.bindFunction(funcComplete); }
     
@@ -337,6 +337,9 @@ void inputGUI::removeGUITutor(GUITutor* t)
     if (Configuration::getInstance().prevSolutionLoaded())
         Configuration::getInstance().removeTutorFromPrev(t->getTutor());
     
+    // And from the timetables kept from the last run
+    TimetablerInst::removeTutorFromCarried( t->getTutor()->getID() );
+    
     
     //reduce the next id
     GUITutor::decrementGlobalID();
@@ -1140,6 +1143,9 @@ void inputGUI::submit(bool noSolve) {
 
 void inputGUI::usePrevious(string filename) {
     
+    // A different configuration, so the last run's timetables are no use to it
+    TimetablerInst::discardPopulation();
+    
     Configuration::getInstance().parseFile(filename.c_str());
     
 #ifdef DEBUG
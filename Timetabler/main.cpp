@@ -51,6 +51,129 @@ int main(int argc, char **argv)
 //    printf("Algorithm execution completed in %i generations\n", TimetablerInst::getInstance().getAlgorithm()->GetAlgorithmStatistics().GetCurrentGeneration() );
 //    
     
+    // Pick the solver: "--anneal" for simulated annealing, "--temper" for parallel tempering,
+    //   "--islands" for the island model GA, "--nsga" for NSGA-II over the criteria as separate objectives,
+    //   otherwise the GA. "--block-crossover" uses TTBlockCrossover in the GA, "--group-crossover" keeps each
+    //   student's interviews together when crossing over and "--adaptive-operators" chooses the mutation operators
+    //   by how well they've been paying off. "--repair" has the crossovers unstack their children.
+    //   "--greedy-init" and "--dsatur-init" start from greedily constructed or DSATUR-coloured timetables instead
+    //   of random ones, and "--matching-seeds N" starts N of the GA's timetables from maximum matchings of
+    //   interviews to slots. "--seed N" builds the same starting population every run. "--candidates N"
+    //   makes up to N candidates for each of the GA's children, rather than one, and "--relinking" has the GA
+    //   relink its elites in the background. "--restarts N" lets the GA restart a stagnant population up to N
+    //   times (0, the default, for never) and "--lns N" runs N large neighbourhood searches alongside it (none by
+    //   default). "--exact-limit N" sets the largest number of interviews a subject component may have for the GA
+    //   to also try solving exactly (0, the default, for never). "--warm-restart" carries the last population over
+    //   each time the configuration's edited, instead of building a new one from scratch.
+    //   "--time-limit S" stops each solve after S seconds with the best timetable found by then
+    const char* solveFile = NULL;
+    const char* benchmarkFile = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        if ( string(argv[i]) == "--anneal" ) {
+            TimetablerInst::setSolver(TT_SOLVER_ANNEALING);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--temper" ) {
+            TimetablerInst::setSolver(TT_SOLVER_TEMPERING);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--islands" ) {
+            TimetablerInst::setSolver(TT_SOLVER_ISLANDS);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--nsga" ) {
+            TimetablerInst::setSolver(TT_SOLVER_NSGA);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--block-crossover" ) {
+            TimetablerInst::setBlockCrossover(true);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--group-crossover" ) {
+            TimetablerInst::setGroupCrossover(true);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--adaptive-operators" ) {
+            TimetablerInst::setAdaptiveOperators(true);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--repair" ) {
+            TimetablerInst::setRepairCrossover(true);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--greedy-init" ) {
+            TimetablerInst::setInitMode(TT_INIT_GREEDY);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--dsatur-init" ) {
+            TimetablerInst::setInitMode(TT_INIT_DSATUR);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--matching-seeds" && i+1 < argc ) {
+            TimetablerInst::setMatchingSeeds( atoi(argv[i+1]) );
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--seed" && i+1 < argc ) {
+            TimetablerInst::setSeed( strtoul(argv[i+1], NULL, 10) );
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--candidates" && i+1 < argc ) {
+            TimetablerInst::setCandidates( atoi(argv[i+1]) );
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--relinking" ) {
+            TimetablerInst::setPathRelinking(true);
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--restarts" && i+1 < argc ) {
+            TimetablerInst::setRestarts( atoi(argv[i+1]) );
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--lns" && i+1 < argc ) {
+            TimetablerInst::setSearchWorkers( atoi(argv[i+1]) );
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--exact-limit" && i+1 < argc ) {
+            TimetablerInst::setExactLimit( atoi(argv[i+1]) );
+            TimetablerInst::reset();
+        }
+        else if ( string(argv[i]) == "--warm-restart" ) {
+            TimetablerInst::setWarmRestart(true);
+        }
+        else if ( string(argv[i]) == "--time-limit" && i+1 < argc ) {
+            TimetablerInst::setTimeLimit( atof(argv[i+1]) );
+        }
+        else if ( string(argv[i]) == "--solve" && i+1 < argc ) {
+            solveFile = argv[i+1];
+        }
+        else if ( string(argv[i]) == "--benchmark-crossover" && i+1 < argc ) {
+            benchmarkFile = argv[i+1];
+        }
+    }
+    
+    // "--benchmark-crossover <config file>" compares the crossover modes on the given config, with the settings
+    //   above, and exits
+    if (benchmarkFile) {
+        if ( Configuration::getInstance().parseFile(benchmarkFile) ) { cerr << "Error when opening config file \"" << benchmarkFile << "\". Does it exist?\n"; exit(EXIT_FAILURE); }
+        TimetablerInst::reset();
+        TimetablerInst::getInstance()->benchmarkCrossover(100, 10000);
+        return 0;
+    }
+    
+    // "--solve <config file>" solves the given config without the server, for --time-limit seconds (60 if not given),
+    //   writing each new best to solution.csv as the GUI does, then exits
+    if (solveFile) {
+        if ( Configuration::getInstance().parseFile(solveFile) ) { cerr << "Error when opening config file \"" << solveFile << "\". Does it exist?\n"; exit(EXIT_FAILURE); }
+        TimetablerInst::reset();
+        
+        double seconds = TimetablerInst::getTimeLimit() > 0 ? TimetablerInst::getTimeLimit() : 60;
+        GaChromosomePtr best = TimetablerInst::getInstance()->solveFor(seconds);
+        
+        printf("Finished after %i generations with a fitness of %f\n", TimetablerInst::getInstance()->getAlgorithm()->GetAlgorithmStatistics().GetCurrentGeneration(), best->GetFitness());
+        return 0;
+    }
+    
     // To hold the command line arguemnts that would normally be passed to the server
     char *params[6];
     params[0] = argv[0];
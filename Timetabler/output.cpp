@@ -9,6 +9,7 @@
 #include "output.h"
 
 outputCSV outputCSV::_instance;
+outputBreakdownCSV outputBreakdownCSV::_instance;
 outputSolution outputSolution::_instance;
 
 using namespace Chromosome;
@@ -87,6 +88,26 @@ void outputCSV::operator()(char *filename, const GaChromosome& chromo, bool deta
     fclose(f);
 }
 
+// output how the solution did on each criterion as a CSV, apart from the timetable so that stays a plain table
+void outputBreakdownCSV::operator()(char *filename, const GaChromosome& chromo) {
+    
+    FILE * f = fopen(filename, "w");
+    if (!f) {
+        cerr << "Couldn't open " << filename << " to write the breakdown to\n";
+        return;
+    }
+    
+    TTBreakdown breakdown = TTFitness::breakdown( dynamic_cast<const Chromosone*>(&chromo) );
+    
+    fprintf(f, "Criterion,Met,Of,Score\n");
+    for (int i = 0; i < TT_NUM_CRITERIA; i++) {
+        if ( !breakdown.of[i] ) continue;
+        fprintf(f, "\"%s\",%i,%i,%.4f\n", TTFitness::getName( (TTCriterion)i ), breakdown.met[i], breakdown.of[i], breakdown.getPoints( (TTCriterion)i ));
+    }
+    
+    fclose(f);
+}
+
 
 timetableSlot::timetableSlot(int slot, Student* student) :
     _slot(slot),
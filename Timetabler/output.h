@@ -140,6 +140,17 @@ public:
     static inline outputCSV getInstance(){ return _instance; }
 };
 
+// output how the timetable did on each criterion (see TTFitness::breakdown) as a CSV file
+class outputBreakdownCSV {
+    static outputBreakdownCSV _instance;
+    
+public:
+    
+    void operator ()(char * filename, const GaChromosome& chromo);
+    
+    static inline outputBreakdownCSV getInstance(){ return _instance; }
+};
+
 // A class for assembling the completed timetable, ready to be printed
 class timetableSlot {
 